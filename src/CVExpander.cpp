@@ -12,6 +12,7 @@ struct CVExpander : Module {
         ENUMS(CV1_OUTPUT, 8),
         ENUMS(CV2_OUTPUT, 8),
         ENUMS(CV3_OUTPUT, 8),
+        ENUMS(POLY_OUTPUT, 3),  // One per column, sequencer 1-8 on channels 1-8
         OUTPUTS_LEN
     };
     enum LightId {
@@ -19,11 +20,33 @@ struct CVExpander : Module {
         LIGHTS_LEN
     };
 
-    LCXLExpanderMessage leftMessages[2];
-    LCXLExpanderMessage expanderMessage;  // For forwarding to right
+    LCXLChainLink link;  // Core's shared snapshot, received from the left and passed on
+    dsp::ClockDivider controlDivider;  // Control-rate scheduler, division follows Core
+
+    // Voltage settings, as the sequencers' (0=5V, 1=10V, 2=1V). FOLLOW_SEQUENCER
+    // uses each sequencer's Seq A range and polarity.
+    static constexpr int FOLLOW_SEQUENCER = -1;
+    int voltageRange = 1;
+    bool bipolar = false;
+    float smoothTime = 0.005f;  // One-pole time constant in seconds (0 = off)
+
+    // All 24 CVs as 6 vectors: column c (CV 1-3), sequencers 1-4 in [2c], 5-8 in [2c + 1]
+    simd::float_4 target[6];
+    simd::float_4 current[6];
+    bool settling = false;      // Outputs still moving towards target
+    bool targetValid = false;   // target matches Core's CVs and the voltage settings
+    uint32_t shownCVRevision = 0;  // Core's cvRevision target was computed from
+    float coefficient = 1.f;    // Per-sample smoothing coefficient
+    float coefficientSampleTime = 0.f;
+    float coefficientSmoothTime = -1.f;
 
     CVExpander() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+        controlDivider.setDivision(32);
+        for (int i = 0; i < 6; i++) {
+            target[i] = 0.f;
+            current[i] = 0.f;
+        }
 
         // Configure CV outputs
         for (int i = 0; i < 8; i++) {
@@ -31,10 +54,12 @@ struct CVExpander : Module {
             configOutput(CV2_OUTPUT + i, string::f("Sequencer %d CV 2", i + 1));
             configOutput(CV3_OUTPUT + i, string::f("Sequencer %d CV 3", i + 1));
         }
+        for (int c = 0; c < 3; c++) {
+            configOutput(POLY_OUTPUT + c, string::f("Polyphonic CV %d (sequencers 1-8)", c + 1));
+        }
 
         // Setup expander message buffers
-        leftExpander.producerMessage = &leftMessages[0];
-        leftExpander.consumerMessage = &leftMessages[1];
+        link.attach(this);
     }
 
     bool isValidExpander(Module* m) {
@@ -45,48 +70,132 @@ struct CVExpander : Module {
     }
 
     void process(const ProcessArgs& args) override {
-        bool connected = false;
-        LCXLExpanderMessage* msg = nullptr;
-
-        // Check if connected to Core or another expander on the left
-        if (isValidExpander(leftExpander.module)) {
-            msg = reinterpret_cast<LCXLExpanderMessage*>(leftExpander.consumerMessage);
-            if (msg && msg->moduleId >= 0) {
-                connected = true;
-
-                for (int s = 0; s < 8; s++) {
-                    auto& seq = msg->sequencers[s];
-
-                    // Output CV values (0-127 mapped to 0-10V)
-                    outputs[CV1_OUTPUT + s].setVoltage(seq.cv1 / 127.f * 10.f);
-                    outputs[CV2_OUTPUT + s].setVoltage(seq.cv2 / 127.f * 10.f);
-                    outputs[CV3_OUTPUT + s].setVoltage(seq.cv3 / 127.f * 10.f);
-                }
+        bool controlTick = controlDivider.process();  // Lights/display run at Core's control rate
 
-                // Store for forwarding
-                expanderMessage = *msg;
+        // Get Core's snapshot from the left neighbour and pass it on to the right
+        bool fresh = false;  // Core published since the last frame
+        const LCXLExpanderMessage* msg = link.receive(this, isValidExpander(leftExpander.module), &fresh);
+        bool connected = msg != nullptr;
+        link.forward(rightExpander.module);
+
+        if (connected) {
+            controlDivider.setDivision(msg->controlRateDivision);
+
+            // New CV values or settings: new targets for the smoother
+            if (!targetValid || (fresh && msg->cvRevision != shownCVRevision)) {
+                updateTarget(msg);
+            }
+        } else if (targetValid) {
+            // If not connected, glide to zero
+            for (int i = 0; i < 6; i++) {
+                target[i] = 0.f;
             }
+            targetValid = false;
+            settling = true;
         }
 
-        // Forward message to right expander
-        if (rightExpander.module && connected) {
-            LCXLExpanderMessage* rightMsg = reinterpret_cast<LCXLExpanderMessage*>(rightExpander.module->leftExpander.producerMessage);
-            if (rightMsg) {
-                *rightMsg = expanderMessage;
-                rightExpander.module->leftExpander.messageFlipRequested = true;
+        // Smooth all 24 CVs at once; idle once they reached their targets
+        if (settling) {
+            if (args.sampleTime != coefficientSampleTime || smoothTime != coefficientSmoothTime) {
+                coefficientSampleTime = args.sampleTime;
+                coefficientSmoothTime = smoothTime;
+                coefficient = smoothTime > 0.f ? 1.f - std::exp(-args.sampleTime / smoothTime) : 1.f;
             }
+            int moving = 0;
+            for (int i = 0; i < 6; i++) {
+                simd::float_4 delta = target[i] - current[i];
+                simd::float_4 arrived = simd::abs(delta) <= 1e-4f;
+                current[i] = simd::ifelse(arrived, target[i], current[i] + delta * coefficient);
+                moving |= simd::movemask(arrived) ^ 0xF;
+            }
+            settling = moving != 0;
+            writeOutputs();
         }
 
-        // If not connected, output zeros
-        if (!connected) {
-            for (int s = 0; s < 8; s++) {
-                outputs[CV1_OUTPUT + s].setVoltage(0.f);
-                outputs[CV2_OUTPUT + s].setVoltage(0.f);
-                outputs[CV3_OUTPUT + s].setVoltage(0.f);
-            }
+        if (controlTick) {
+            lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        }
+    }
+
+    // Convert Core's CVs (0-127) to volts with the voltage settings, 4 at a time
+    void updateTarget(const LCXLExpanderMessage* msg) {
+        static const float RANGE_VOLTS[3] = {5.f, 10.f, 1.f};  // Full scale per range, as knobToVoltage
+        shownCVRevision = msg->cvRevision;
+
+        alignas(16) int32_t knobs[24];
+        alignas(16) float maxVoltage[8];
+        alignas(16) float offset[8];
+        for (int s = 0; s < 8; s++) {
+            auto& seq = msg->sequencers[s];
+            knobs[s] = seq.cv1;
+            knobs[8 + s] = seq.cv2;
+            knobs[16 + s] = seq.cv3;
+
+            int range = voltageRange == FOLLOW_SEQUENCER ? seq.voltageRangeA : voltageRange;
+            bool bi = voltageRange == FOLLOW_SEQUENCER ? seq.bipolarA : bipolar;
+            maxVoltage[s] = RANGE_VOLTS[(range >= 0 && range < 3) ? range : 0];
+            offset[s] = bi ? maxVoltage[s] / 2.f : 0.f;
         }
 
-        lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        bool changed = false;
+        for (int i = 0; i < 6; i++) {
+            int half = (i % 2) * 4;  // Sequencers 1-4 or 5-8 of the column
+            simd::float_4 knob = simd::float_4(simd::int32_4::load(&knobs[i * 4]));
+            simd::float_4 volts = knob * (1.f / 127.f) * simd::float_4::load(&maxVoltage[half])
+                                  - simd::float_4::load(&offset[half]);
+            changed |= simd::movemask(volts != target[i]) != 0;
+            target[i] = volts;
+        }
+        if (!targetValid) {
+            // Settings changed or just connected: outputs may need rewriting even if
+            // the targets happen to be the same
+            changed = true;
+            targetValid = true;
+        }
+        if (changed) settling = true;
+    }
+
+    void writeOutputs() {
+        alignas(16) float volts[24];
+        for (int i = 0; i < 6; i++) {
+            current[i].store(&volts[i * 4]);
+        }
+        for (int s = 0; s < 8; s++) {
+            outputs[CV1_OUTPUT + s].setVoltage(volts[s]);
+            outputs[CV2_OUTPUT + s].setVoltage(volts[8 + s]);
+            outputs[CV3_OUTPUT + s].setVoltage(volts[16 + s]);
+        }
+        for (int c = 0; c < 3; c++) {
+            Output& poly = outputs[POLY_OUTPUT + c];
+            poly.setChannels(8);
+            poly.setVoltageSimd(current[c * 2], 0);
+            poly.setVoltageSimd(current[c * 2 + 1], 4);
+        }
+    }
+
+    // Settings are changed from the UI thread; targets are recomputed on the next frame
+    void setVoltageRange(int range, bool bi) {
+        voltageRange = range;
+        bipolar = bi;
+        targetValid = false;
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "voltageRange", json_integer(voltageRange));
+        json_object_set_new(rootJ, "bipolar", json_boolean(bipolar));
+        json_object_set_new(rootJ, "smoothTime", json_real(smoothTime));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        json_t* rangeJ = json_object_get(rootJ, "voltageRange");
+        json_t* bipolarJ = json_object_get(rootJ, "bipolar");
+        if (rangeJ && bipolarJ) {
+            setVoltageRange(clamp((int) json_integer_value(rangeJ), FOLLOW_SEQUENCER, 2), json_boolean_value(bipolarJ));
+        }
+        json_t* smoothJ = json_object_get(rootJ, "smoothTime");
+        if (smoothJ) smoothTime = clamp((float) json_number_value(smoothJ), 0.f, 1.f);
     }
 };
 
@@ -149,6 +258,12 @@ struct CVExpanderWidget : ModuleWidget {
         addLabel(mm2px(Vec(10, 14)), mm2px(Vec(15, 4)), "CV 2");
         addLabel(mm2px(Vec(20, 14)), mm2px(Vec(15, 4)), "CV 3");
 
+        // Polyphonic outputs, one per column (8 channels = sequencers 1-8)
+        for (int c = 0; c < 3; c++) {
+            addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(7.5 + c * 10, 103)), module, CVExpander::POLY_OUTPUT + c));
+        }
+        addLabel(mm2px(Vec(10, 96.5)), mm2px(Vec(15, 3)), "POLY", 5.f);
+
         // Row numbers (on the right side)
         for (int i = 0; i < 8; i++) {
             addLabel(mm2px(Vec(31, 20 + i * 10)), mm2px(Vec(5, 4)), std::to_string(i + 1), 6.f);
@@ -159,6 +274,46 @@ struct CVExpanderWidget : ModuleWidget {
         // Brand below line
         addLabel(mm2px(Vec(10, 120)), mm2px(Vec(15, 8)), "LCXL", 14.f);
     }
+
+    void appendContextMenu(Menu* menu) override {
+        CVExpander* module = dynamic_cast<CVExpander*>(this->module);
+        if (!module) return;
+
+        static const char* rangeNames[3] = {"5V", "10V", "1V"};
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createSubmenuItem("Voltage range",
+            module->voltageRange == CVExpander::FOLLOW_SEQUENCER ? "Sequencer A" : rangeNames[module->voltageRange],
+            [=](Menu* menu) {
+                menu->addChild(createCheckMenuItem("Each sequencer's Seq A setting", "",
+                    [=]() { return module->voltageRange == CVExpander::FOLLOW_SEQUENCER; },
+                    [=]() { module->setVoltageRange(CVExpander::FOLLOW_SEQUENCER, module->bipolar); }
+                ));
+                for (int r = 0; r < 3; r++) {
+                    menu->addChild(createCheckMenuItem(rangeNames[r], "",
+                        [=]() { return module->voltageRange == r; },
+                        [=]() { module->setVoltageRange(r, module->bipolar); }
+                    ));
+                }
+            }
+        ));
+        menu->addChild(createCheckMenuItem("Bipolar", "",
+            [=]() { return module->bipolar; },
+            [=]() { module->setVoltageRange(module->voltageRange, !module->bipolar); },
+            module->voltageRange == CVExpander::FOLLOW_SEQUENCER
+        ));
+
+        menu->addChild(createSubmenuItem("Smoothing", module->smoothTime > 0.f ? string::f("%g ms", module->smoothTime * 1000.f) : "Off",
+            [=](Menu* menu) {
+                static const float times[] = {0.f, 0.002f, 0.005f, 0.02f, 0.1f};
+                for (float t : times) {
+                    menu->addChild(createCheckMenuItem(t > 0.f ? string::f("%g ms", t * 1000.f) : "Off", "",
+                        [=]() { return module->smoothTime == t; },
+                        [=]() { module->smoothTime = t; }
+                    ));
+                }
+            }
+        ));
+    }
 };
 
 Model* modelCVExpander = createModel<CVExpander, CVExpanderWidget>("CVExpander");
@@ -1,5 +1,6 @@
 #include "plugin.hpp"
 #include "ExpanderMessage.hpp"
+#include "SequencerEngine.hpp"
 
 struct ClockExpander : Module {
     enum ParamId {
@@ -20,8 +21,19 @@ struct ClockExpander : Module {
 
     ClockExpanderMessage rightMessages[2];
 
+    // Chaining map, resolved when cables change: input index each sequencer's
+    // clock A/B is taken from, or -1 if none
+    int clockSourceA[8];
+    int clockSourceB[8];
+
+    // One edge detector per input jack, shared by all sequencers chained to it
+    ClockEdgeDetector edgeDetectors[INPUTS_LEN];
+
+    dsp::ClockDivider lightDivider;  // Connection light runs at control rate
+
     ClockExpander() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+        lightDivider.setDivision(32);
 
         // Configure clock inputs
         for (int i = 0; i < 8; i++) {
@@ -32,6 +44,26 @@ struct ClockExpander : Module {
         // Setup expander message buffers (sending TO the right, i.e., to Core)
         rightExpander.producerMessage = &rightMessages[0];
         rightExpander.consumerMessage = &rightMessages[1];
+
+        resolveClockSources();
+    }
+
+    void onPortChange(const PortChangeEvent& e) override {
+        resolveClockSources();
+    }
+
+    void resolveClockSources() {
+        int chainedA = -1;
+        for (int s = 0; s < 8; s++) {
+            // Clock A with chaining: this input, else the nearest connected one above it
+            if (inputs[CLK_A_INPUT + s].isConnected()) {
+                chainedA = CLK_A_INPUT + s;
+            }
+            clockSourceA[s] = chainedA;
+
+            // Clock B: only normaled to own Clock A, not chained
+            clockSourceB[s] = inputs[CLK_B_INPUT + s].isConnected() ? CLK_B_INPUT + s : chainedA;
+        }
     }
 
     void process(const ProcessArgs& args) override {
@@ -45,40 +77,41 @@ struct ClockExpander : Module {
                 connected = true;
                 msg->moduleId = id;
 
-                // Process each sequencer's clocks
-                for (int s = 0; s < 8; s++) {
-                    // Clock A with chaining: check this input, then previous ones in chain
-                    float clockAVoltage = 0.f;
-                    bool hasClockA = false;
-
-                    // Check from this sequencer backwards to find connected clock
-                    for (int i = s; i >= 0; i--) {
-                        if (inputs[CLK_A_INPUT + i].isConnected()) {
-                            clockAVoltage = inputs[CLK_A_INPUT + i].getVoltage();
-                            hasClockA = true;
-                            break;
-                        }
+                // Detect edges once per connected jack
+                uint32_t rose = 0;
+                for (int i = 0; i < INPUTS_LEN; i++) {
+                    if (inputs[i].isConnected() && edgeDetectors[i].process(inputs[i].getVoltage())) {
+                        rose |= 1 << i;
                     }
+                }
 
-                    msg->clockA[s] = clockAVoltage;
-                    msg->hasClockA[s] = hasClockA;
-
-                    // Clock B: only normaled to own Clock A, not chained
-                    if (inputs[CLK_B_INPUT + s].isConnected()) {
-                        msg->clockB[s] = inputs[CLK_B_INPUT + s].getVoltage();
-                        msg->hasClockB[s] = true;
-                    } else {
-                        // Normal to this sequencer's clock A
-                        msg->clockB[s] = clockAVoltage;
-                        msg->hasClockB[s] = hasClockA;  // Only has B if A is connected
+                // Map jack edges to sequencer edge bits through the chaining map
+                uint16_t edges = 0;
+                uint8_t clocked = 0;
+                for (int s = 0; s < 8; s++) {
+                    int srcA = clockSourceA[s];
+                    int srcB = clockSourceB[s];
+                    if (srcA < 0) continue;  // Clock B alone doesn't clock a sequencer from here
+                    clocked |= 1 << s;
+                    if (rose & (1 << srcA)) {
+                        edges |= 1 << s;
+                        msg->edgeOffsets[s] = edgeDetectors[srcA].offset;
+                    }
+                    if (rose & (1 << srcB)) {
+                        edges |= 1 << (8 + s);
+                        msg->edgeOffsets[8 + s] = edgeDetectors[srcB].offset;
                     }
                 }
+                msg->risingEdges = edges;
+                msg->clockedSeqs = clocked;
 
                 rightExpander.module->leftExpander.messageFlipRequested = true;
             }
         }
 
-        lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        if (lightDivider.process()) {
+            lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        }
     }
 };
 
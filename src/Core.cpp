@@ -1,52 +1,16 @@
 #include "plugin.hpp"
 #include "ExpanderMessage.hpp"
+#include "SequencerEngine.hpp"
+#include "LCXLDevice.hpp"
+#include "LCXLProtocol.hpp"
+#include "PresetLibrary.hpp"
+#include "EditJournal.hpp"
+#ifdef VIRTUAL_LCXL
+#include "VirtualLCXL.hpp"
+#endif
 #include <midi.hpp>
 #include <cstring>  // for memset, memcpy
 
-// Launch Control XL Factory Template 1 MIDI mappings (Channel 9)
-namespace LCXL {
-    // CC numbers for knobs (3 rows of 8)
-    constexpr int KNOB_ROW1[] = {13, 14, 15, 16, 17, 18, 19, 20};  // Send A
-    constexpr int KNOB_ROW2[] = {29, 30, 31, 32, 33, 34, 35, 36};  // Send B
-    constexpr int KNOB_ROW3[] = {49, 50, 51, 52, 53, 54, 55, 56};  // Pan/Device
-
-    // CC numbers for faders
-    constexpr int FADERS[] = {77, 78, 79, 80, 81, 82, 83, 84};
-
-    // Note numbers for buttons
-    constexpr int TRACK_FOCUS[] = {41, 42, 43, 44, 57, 58, 59, 60};
-    constexpr int TRACK_CONTROL[] = {73, 74, 75, 76, 89, 90, 91, 92};
-
-    // CC numbers for navigation buttons
-    constexpr int BTN_UP = 104;
-    constexpr int BTN_DOWN = 105;
-    constexpr int BTN_LEFT = 106;
-    constexpr int BTN_RIGHT = 107;
-
-    // Button indices for Device, Mute, Solo, Record Arm
-    constexpr int BTN_DEVICE = 105;  // Note number
-    constexpr int BTN_MUTE = 106;
-    constexpr int BTN_SOLO = 107;
-    constexpr int BTN_REC_ARM = 108;
-
-    // LED color values (bits 0-1: red 0-3, bits 4-5: green 0-3, base 12)
-    constexpr uint8_t LED_OFF = 12;
-    constexpr uint8_t LED_RED_LOW = 13;
-    constexpr uint8_t LED_RED_FULL = 15;
-    constexpr uint8_t LED_GREEN_LOW = 28;
-    constexpr uint8_t LED_GREEN_FULL = 60;
-    constexpr uint8_t LED_AMBER_LOW = 29;
-    constexpr uint8_t LED_AMBER_FULL = 63;
-    constexpr uint8_t LED_YELLOW_LOW = 30;
-    constexpr uint8_t LED_YELLOW_FULL = 62;
-
-    // SysEx header for Launch Control XL
-    constexpr uint8_t SYSEX_HEADER[] = {0x00, 0x20, 0x29, 0x02, 0x11};
-
-    // Factory template 1 uses MIDI channel 9 (index 8)
-    constexpr int MIDI_CHANNEL = 8;
-}
-
 struct Core : Module {
     enum ParamId {
         TAKEOVER_PARAM,
@@ -56,6 +20,11 @@ struct Core : Module {
         CLOCK_A_INPUT,
         CLOCK_B_INPUT,
         RESET_INPUT,
+        MOD_BIAS_INPUT,          // Sequencer parameter modulation, one channel per sequencer
+        MOD_STEP_LENGTH_INPUT,
+        MOD_VALUE_LENGTH_INPUT,
+        MOD_CV_INPUT,
+        MOD_DENSITY_INPUT,
         INPUTS_LEN
     };
     enum OutputId {
@@ -79,37 +48,16 @@ struct Core : Module {
         LIGHTS_LEN
     };
 
-    // Competition modes (dual mode)
-    enum CompetitionMode {
-        COMP_INDEPENDENT = 0,
-        COMP_STEAL,
-        COMP_A_PRIORITY,
-        COMP_B_PRIORITY,
-        COMP_MOMENTUM,
-        COMP_REVENGE,
-        COMP_ECHO,
-        COMP_VALUE_THEFT
-    };
-
-    // Routing modes (single mode)
-    enum RoutingMode {
-        ROUTE_ALL_A = 0,
-        ROUTE_ALL_B,
-        ROUTE_BERNOULLI,
-        ROUTE_ALTERNATE,
-        ROUTE_TWO_TWO,
-        ROUTE_BURST,
-        ROUTE_PROBABILITY,
-        ROUTE_PATTERN
-    };
-
     bool takenOver = false;
+
+    // Control-rate scheduler: non-audio work runs once every controlRateDivision frames
+    static constexpr int DEFAULT_CONTROL_RATE_DIVISION = 32;
+    int controlRateDivision = DEFAULT_CONTROL_RATE_DIVISION;
+    dsp::ClockDivider controlDivider;
     dsp::BooleanTrigger takeoverTrigger;
-    dsp::SchmittTrigger clockTriggerA;
-    dsp::SchmittTrigger clockTriggerB;
     dsp::SchmittTrigger resetTrigger;
-    dsp::SchmittTrigger perSeqClockTriggerA[8];  // Per-sequencer clock A triggers
-    dsp::SchmittTrigger perSeqClockTriggerB[8];  // Per-sequencer clock B triggers
+    ClockEdgeDetector clockEdgeA;  // Module clock A input (with sub-sample offset)
+    ClockEdgeDetector clockEdgeB;  // Module clock B input, normaled to A
     dsp::PulseGenerator trigPulseA[8];   // Trigger A pulse for each sequencer
     dsp::PulseGenerator trigPulseB[8];   // Trigger B pulse for each sequencer
 
@@ -119,18 +67,82 @@ struct Core : Module {
     midi::InputQueue midiInput;
     midi::Output midiOutput;
 
+    // MIDI clock and transport. While a device is selected, its clock replaces the
+    // module's clock inputs, divided per sequencer (Sequencer::midiClockDivision).
+    midi::InputQueue clockInput;
+    MidiClockDivider midiClock;
+
+    // Device template this Core listens to and draws its LEDs on (8-15 = Factory 1-8).
+    // Several Cores can share one controller by using different templates.
+    int deviceTemplate = LCXL::FACTORY_TEMPLATE_1;
+    std::shared_ptr<LCXLDevice> device;  // Shared LED mirror of the connected controller
+    LCXLDevice::LEDQueue ledQueue;       // Our LED changes not sent yet
+
     // Current state
     int currentLayout = 0;  // 0 = default, 1-8 = sequencers
     int outputLayout = 0;   // Which layout's sequencer to output (0 = follow currentLayout)
+    int viewPage[8] = {0};  // Step page shown on the buttons per sequencer (Left/Right)
     bool deviceButtonHeld = false;
     bool recArmHeld = false;          // For mode selection (hold + track focus)
+    bool muteHeld = false;            // For pattern selection (hold + step button)
+    bool soloHeld = false;            // Trig conditions; with Mute: store the live pattern instead of switching; with Device: browse presets
+
+    // Step generators (Device + knobs). Their step edits are journaled as one edit
+    // when Device is released.
+    bool generatorEdit = false;       // A generator changed the steps while Device is held
+    int generatorLayout = 0;          // Layout the generator edited
+    Sequencer generatorBefore;        // Its sequencer before the first generator change
     int lastMidiOutputDeviceId = -1;  // Track MIDI output connection for auto-init
 
     // Fader values (0-127 MIDI, converted to 0-10V)
     int faderValues[8] = {0};
 
+    // Sequencer parameter modulation (MOD inputs). Voltages are added to the
+    // sequencers' parameter knobs, 8 sequencers per pass (2 x float_4).
+    static constexpr int NUM_MODS = 5;  // Bias, step length A, value length A, CV offset, density
+    bool modConnected[NUM_MODS] = {false};
+    float modBiasBase[8] = {0.f};          // Bias knobs (0-127) the modulation is added to
+    uint32_t modBiasRevision = ~0u;        // knobRevision modBiasBase was read at
+    float modBias[8] = {0.f};              // Bias last set by modulation (-1 = set it again)
+    float modLengthBase[2][8] = {{0.f}};   // Unmodulated step/value length A
+    float modMaxLength[2][8] = {{0.f}};    // Longest step/value length A (with the current pages)
+    uint32_t modLengthRevision[2] = {~0u, ~0u};  // engine.lengthRevision the lengths were read at
+    float modLengths[2][8] = {{0.f}};      // Step/value length A last set by modulation (0 = none)
+    float modDensity[8] = {0.f};           // Density offset last set by modulation
+    float cvOffsets[8] = {0.f};            // CV 1-3 offset in knob steps, added in the expander snapshot
+
+    // CV 1-3 and Seq A voltage settings last published per sequencer (packed), so
+    // CVExpander only converts them again when cvRevision moves
+    uint32_t publishedCVs[8] = {~0u, ~0u, ~0u, ~0u, ~0u, ~0u, ~0u, ~0u};
+    uint32_t cvRevision = 0;
+
     // Knob values per layout (0 = default, 1-8 = sequencers)
     int knobValues[9][24] = {{0}};
+    uint32_t knobRevision = 0;  // Incremented whenever knobValues change
+
+    // Layout morph: a fader crossfades all 24 knobs between two layouts.
+    // The result replaces the knob outputs (KnobExpander) and, optionally, the
+    // value knobs one sequencer plays.
+    int morphFader = -1;     // Fader 0-7 (-1 = morph off)
+    int morphFrom = 1;       // Layout at fader minimum (0 = default, 1-8 = sequencers)
+    int morphTo = 2;         // Layout at fader maximum
+    int morphSequencer = 0;  // Sequencer 1-8 that plays the morphed values (0 = none)
+    float morphKnobs[24] = {0.f};  // Morphed knob values (0-127)
+    int lastMorphFader = -1;       // Fader value the morph was computed for
+    uint32_t morphRevision = 0;    // knobRevision the morph was computed for
+    uint32_t morphKnobsRevision = 0;  // Incremented whenever morphKnobs change
+
+    // Preset library, browsed with Device + Solo + knobs 1-2 in a sequencer layout
+    PresetLibrary presetLibrary;
+    int selectedPreset = -1;  // Record last selected from the controller (-1 = none)
+
+    // Undo history of controller edits (Device + Left/Right, or the menu).
+    // Menu requests are counted here and carried out on the audio thread.
+    EditJournal journal;
+    std::atomic<int> undoRequests{0};
+    std::atomic<int> redoRequests{0};
+    float lastJournalTime = 0.f;  // currentTime of the last journaled edit
+    static constexpr float JOURNAL_MERGE_TIME = 1.f;  // A longer pause ends a knob turn
 
     // Button toggle states for default layout (16 buttons)
     bool buttonStates[16] = {false};
@@ -138,67 +150,17 @@ struct Core : Module {
     // Button momentary mode for default layout (true = momentary, false = toggle)
     bool buttonMomentary[16] = {false};
 
-    // Sequencer states (8 sequencers)
-    struct Sequencer {
-        bool steps[16] = {false};       // Step on/off (all 16 buttons)
-
-        // Length parameters (from knobs 1-4)
-        int valueLengthA = 8;           // Value length for Seq A (1-16, >=9 = single mode)
-        int valueLengthB = 4;           // Value length for Seq B (0-8, 0=disabled)
-        int stepLengthA = 8;            // Step length for Seq A (1-16)
-        int stepLengthB = 4;            // Step length for Seq B (0-8, 0=disabled)
-
-        // Bias and per-sequencer CV values (from knobs 5-8)
-        float bias = 0.5f;              // Competition/routing bias (0-1)
-        int cv1 = 0;                    // Per-sequencer CV 1 (MIDI 0-127)
-        int cv2 = 0;                    // Per-sequencer CV 2 (MIDI 0-127)
-        int cv3 = 0;                    // Per-sequencer CV 3 (MIDI 0-127)
-
-        // Mode selection
-        int competitionMode = COMP_INDEPENDENT;  // For dual mode
-        int routingMode = ROUTE_ALL_A;           // For single mode
-
-        // Voltage settings (0=5V green, 1=10V amber, 2=1V red)
-        int voltageRangeA = 0;
-        int voltageRangeB = 0;
-        bool bipolarA = false;
-        bool bipolarB = false;
-
-        // Playback state
-        int currentStepA = 0;           // Current step position for Seq A
-        int currentStepB = 0;           // Current step position for Seq B
-        int currentValueIndexA = 0;     // Current value index for Seq A
-        int currentValueIndexB = 0;     // Current value index for Seq B
-
-        // Momentum/revenge state for competition modes
-        float momentumA = 0.5f;         // Current win chance for A
-        float momentumB = 0.5f;         // Current win chance for B
-        bool lastWinnerA = true;        // Who won last (for revenge mode)
-        bool pendingEchoB = false;      // Echo pending for B
-        bool pendingEchoA = false;      // Echo pending for A
-
-        // Routing state for single mode
-        int alternateCounter = 0;       // Counter for alternate/2+2 modes
-
-        // Per-step glide times (0 = instant, 127 = slow ~3 seconds)
-        int glideTime[16] = {0};        // Glide time for transition FROM each value position
-        float currentSlewA = 0.f;       // Current slewed CV output for A
-        float currentSlewB = 0.f;       // Current slewed CV output for B
-        int prevValueIndexA = 0;        // Previous value index for detecting transitions
-        int prevValueIndexB = 0;        // Previous value index for B
-        float activeGlideA = 0.f;       // Currently active glide time for A (seconds)
-        float activeGlideB = 0.f;       // Currently active glide time for B (seconds)
-
-        // Helper to check if values are in single mode (all 16 knobs for one seq)
-        bool isValueSingleMode() const { return valueLengthA >= 9; }
-        // Helper to check if steps are in single mode (all 16 buttons for one seq)
-        bool isStepSingleMode() const { return stepLengthA >= 9; }
-    };
-    Sequencer sequencers[8];
+    uint32_t buttonRevision = 0;       // Incremented whenever buttonStates change
+    uint32_t buttonPresses[16] = {0};  // Default layout presses per button (for press triggers)
+
+    // Sequencer states and clock/competition logic (8 sequencers)
+    SequencerEngine engine;
 
     // Soft takeover state for value knobs
-    int lastPhysicalKnobPos[24] = {};  // Will be initialized to -1 in constructor
-    bool knobPickedUp[24] = {};        // Will be initialized to true in constructor
+    // Physical positions are shared by all layouts, pickup state is kept per layout
+    int lastPhysicalKnobPos[24] = {};   // Will be initialized to -1 in constructor
+    bool knobPickedUp[9][24] = {{}};    // Will be initialized to true in constructor
+    int leftKnobPos[9][24] = {{}};      // Physical position when the layout was last left (-1 = never)
 
     // Soft takeover state for glide times (per sequencer, 16 values each)
     int lastPhysicalGlidePos[8][16] = {{0}};  // Last physical position for glide
@@ -209,14 +171,39 @@ struct Core : Module {
     static constexpr float AMBER_DISPLAY_TIME = 0.2f;  // 200ms
     float currentTime = 0.f;  // Accumulated time for amber timeout
 
-    // Expander message for right-side expanders
-    LCXLExpanderMessage expanderMessage;
+    // LED lookahead: playhead LEDs are sent this long before the predicted clock
+    // edge so they land on time despite MIDI output latency (0 = off)
+    float ledLookahead = 0.f;  // Seconds
+    ClockPredictor clockPredictorA[8];  // Per-sequencer clock A period estimators
+    ClockPredictor clockPredictorB[8];  // Per-sequencer clock B period estimators
+    bool lookaheadDueA = false;  // Whether the shown LEDs include a predicted A edge
+    bool lookaheadDueB = false;  // Whether the shown LEDs include a predicted B edge
+    Sequencer ledPreview;        // Viewed sequencer advanced by the predicted edges
+    int64_t currentFrame = 0;
+    float sampleRate = 44100.f;
+
+    // State shared with right-side expanders (the whole chain reads this one snapshot)
+    std::shared_ptr<LCXLSnapshot> snapshot = std::make_shared<LCXLSnapshot>();
+    uint32_t triggerCountA[8] = {0};  // Triggers published so far per sequencer
+    uint32_t triggerCountB[8] = {0};
     bool seqTriggeredAThisFrame[8] = {false};  // Track which sequencers triggered on A
     bool seqTriggeredBThisFrame[8] = {false};  // Track which sequencers triggered on B
+    float seqTriggerOffsetA[8] = {0.f};  // Sub-sample position of this frame's A trigger (samples before frame)
+    float seqTriggerOffsetB[8] = {0.f};  // Sub-sample position of this frame's B trigger
+    float seqTriggerLengthA[8] = {0.f};  // Pulse/gate length of this frame's A trigger (seconds)
+    float seqTriggerLengthB[8] = {0.f};  // Pulse/gate length of this frame's B trigger (seconds)
+
+    // Pending triggers, ratchets, swung steps, echoes and gates per sequencer
+    EventQueue<32> eventQueues[8];
 
     // Last change tracking for InfoDisplay
     LastChangeInfo lastChange;
 
+    // Sequencer view LEDs that need their color recomputed (bit = LED index 0-39)
+    static constexpr uint64_t ALL_SEQUENCER_LEDS = (1ull << 40) - 1;
+    uint64_t dirtyLEDs = 0;
+    int shownPlayheads[4] = {-1, -1, -1, -1};  // Playhead LEDs last rendered (step A/B, value A/B)
+
     // CPU optimization: LED state tracking to avoid redundant SysEx
     // Indices 0-23 = knobs, 24-39 = buttons (Track Focus 24-31, Track Control 32-39)
     uint8_t lastLEDState[40] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
@@ -225,9 +212,20 @@ struct Core : Module {
                                  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
                                  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};  // 0xFF = unknown/force update
 
+    // Repaint of the whole template after (re)connecting or switching back to it,
+    // spread over control-rate ticks instead of blanking and redrawing it at once
+    static constexpr int RESYNC_BATCH = 12;       // LEDs queued per tick
+    int resyncPosition = LCXLDevice::NUM_LEDS;   // Next LED to repaint, NUM_LEDS when done
+
     // CPU optimization: dirty flag for expander message
     bool expanderDirty = true;
 
+    // Whether the buttons currently show a Device/Record Arm/Mute/Solo overlay instead of the sequencer
+    bool isOverlayShown() const {
+        // Generators show the steps they edit, even with Device held
+        return (deviceButtonHeld && !generatorEdit) || recArmHeld || muteHeld || soloHeld;
+    }
+
     void recordChange(ChangeType type, int seq, int value, int step = 0) {
         lastChange.type = type;
         lastChange.sequencer = seq;
@@ -246,6 +244,11 @@ struct Core : Module {
         configInput(CLOCK_A_INPUT, "Clock A");
         configInput(CLOCK_B_INPUT, "Clock B (normaled to A)");
         configInput(RESET_INPUT, "Reset");
+        configInput(MOD_BIAS_INPUT, "Bias modulation (channel = sequencer, 10V = full knob)");
+        configInput(MOD_STEP_LENGTH_INPUT, "Step length A modulation (channel = sequencer, 10V = full knob)");
+        configInput(MOD_VALUE_LENGTH_INPUT, "Value length A modulation (channel = sequencer, 10V = full knob)");
+        configInput(MOD_CV_INPUT, "CV 1-3 offset (channel = sequencer, 10V = full knob)");
+        configInput(MOD_DENSITY_INPUT, "Density modulation (channel = sequencer, 10V = full density)");
 
         // Configure fader outputs
         for (int i = 0; i < 8; i++) {
@@ -261,7 +264,10 @@ struct Core : Module {
         // Initialize soft takeover state
         for (int i = 0; i < 24; i++) {
             lastPhysicalKnobPos[i] = -1;  // Unknown position
-            knobPickedUp[i] = true;        // Start as picked up
+            for (int layout = 0; layout < 9; layout++) {
+                knobPickedUp[layout][i] = true;  // Start as picked up
+                leftKnobPos[layout][i] = -1;
+            }
         }
 
         // Initialize glide pickup state
@@ -272,6 +278,14 @@ struct Core : Module {
             }
         }
 
+        controlDivider.setDivision(controlRateDivision);
+
+        // Only receive our template's channel from the MIDI driver
+        midiInput.channel = deviceTemplate;
+
+        // Seed the engine's random generator from Rack's
+        engine.rng.seed(random::u64(), random::u64());
+
         // Setup left expander message buffers (for ClockExpander)
         leftExpander.producerMessage = &leftMessages[0];
         leftExpander.consumerMessage = &leftMessages[1];
@@ -280,74 +294,44 @@ struct Core : Module {
 
     void onAdd(const AddEvent& e) override {
         Module::onAdd(e);
+
+        // Map the preset library (shared by all Cores) before the controller can browse it
+        std::string dir = asset::user(pluginInstance->slug);
+        system::createDirectories(dir);
+        presetLibrary.open(system::join(dir, "presets.lcxp"));
     }
 
     void process(const ProcessArgs& args) override {
         // Track time for amber display timeout
         currentTime += args.sampleTime;
+        currentFrame = args.frame;
+        sampleRate = args.sampleRate;
 
-        // Check if any amber timer has expired and needs LED update (skip if holding Device/RecArm)
-        if (currentLayout > 0 && !deviceButtonHeld && !recArmHeld) {
-            bool needsUpdate = false;
-            for (int i = 0; i < 4; i++) {
-                if (lengthChangeTime[i] >= 0) {
-                    float elapsed = currentTime - lengthChangeTime[i];
-                    if (elapsed >= AMBER_DISPLAY_TIME) {
-                        lengthChangeTime[i] = -1.f;  // Clear the expired timer
-                        needsUpdate = true;
-                    }
-                }
-            }
-            if (needsUpdate) {
-                updateSequencerLEDs();
-            }
-        }
-
-        // Check for MIDI output device connection change - auto-initialize
-        int currentMidiOutputId = midiOutput.getDeviceId();
-        if (currentMidiOutputId >= 0 && currentMidiOutputId != lastMidiOutputDeviceId) {
-            lastMidiOutputDeviceId = currentMidiOutputId;
-            initializeDevice();
-        } else if (currentMidiOutputId < 0 && lastMidiOutputDeviceId >= 0) {
-            // Device disconnected
-            lastMidiOutputDeviceId = -1;
-            takenOver = false;
-        }
-
-        // Check takeover button using trigger for edge detection
-        if (takeoverTrigger.process(params[TAKEOVER_PARAM].getValue() > 0.f)) {
-            if (!takenOver) {
-                performTakeover();
-            }
-        }
-
-        // Process incoming MIDI messages
-        midi::Message msg;
-        while (midiInput.tryPop(&msg, args.frame)) {
-            processMidiMessage(msg);
-        }
-
-        // Output fader CVs (always active)
-        for (int i = 0; i < 8; i++) {
-            float voltage = faderValues[i] / 127.f * 10.f;
-            outputs[FADER_OUTPUT_1 + i].setVoltage(voltage);
+        // Control-rate work (MIDI, device polling, timers, lights) runs every N frames;
+        // clocks, triggers and slew below stay sample-accurate
+        if (controlDivider.process()) {
+            processControlRate(args);
         }
 
         // Process reset input (resets all sequencers)
         if (resetTrigger.process(inputs[RESET_INPUT].getVoltage())) {
             for (int s = 0; s < 8; s++) {
-                sequencers[s].currentStepA = 0;
-                sequencers[s].currentStepB = 0;
-                sequencers[s].currentValueIndexA = 0;
-                sequencers[s].currentValueIndexB = 0;
-                sequencers[s].alternateCounter = 0;
-            }
-            // Update LEDs if viewing a sequencer (skip if holding Device/RecArm for selection)
-            if (currentLayout > 0 && !deviceButtonHeld && !recArmHeld) {
-                updateSequencerLEDs();
+                // A reset is a loop boundary too
+                if (engine.banks[s].queued >= 0) {
+                    engine.switchToQueuedPattern(s, knobValues[s + 1]);
+                    onPatternLoaded(s);
+                }
+                eventQueues[s].clear();
+            }
+            engine.resetAllPlayheads();
+            // Update LEDs if viewing a sequencer (skip while a button overlay is shown)
+            if (currentLayout > 0 && !isOverlayShown()) {
+                renderSequencerLEDs();  // Only the playheads moved
             }
         }
 
+        processModulation();
+
         // Check for ClockExpander on the left
         bool hasClockExpander = false;
         ClockExpanderMessage* clockMsg = nullptr;
@@ -358,57 +342,125 @@ struct Core : Module {
             }
         }
 
-        // Get default clock voltages (Clock B normals to Clock A)
-        float defaultClockAVoltage = inputs[CLOCK_A_INPUT].getVoltage();
-        float defaultClockBVoltage = inputs[CLOCK_B_INPUT].isConnected() ?
-            inputs[CLOCK_B_INPUT].getVoltage() : defaultClockAVoltage;
+        // Collect this frame's rising clock edges as a bitmask (bit s = clock A of
+        // sequencer s, bit 8+s = clock B) with their sub-sample offsets.
+        // Sequencers clocked by the ClockExpander get its pre-detected edges, all
+        // others share MIDI clock if selected, or else the module's clock inputs
+        // (Clock B normals to Clock A).
+        uint8_t expanderSeqs = hasClockExpander ? clockMsg->clockedSeqs : 0;
+        uint16_t edges = 0;
+        float edgeOffsets[16] = {0.f};
+        if (clockInput.getDeviceId() >= 0) {
+            // MIDI clock steps clock A and B together
+            uint16_t midiSeqs = processClockInput(args.frame, (uint8_t) ~expanderSeqs, edgeOffsets);
+            edges |= midiSeqs | (midiSeqs << 8);
+            for (int s = 0; s < 8; s++) edgeOffsets[8 + s] = edgeOffsets[s];
+        } else if (expanderSeqs != 0xFF) {
+            float clockAVoltage = inputs[CLOCK_A_INPUT].getVoltage();
+            float clockBVoltage = inputs[CLOCK_B_INPUT].isConnected() ?
+                inputs[CLOCK_B_INPUT].getVoltage() : clockAVoltage;
+            uint16_t localSeqs = (uint8_t) ~expanderSeqs;
+            if (clockEdgeA.process(clockAVoltage)) {
+                edges |= localSeqs;
+                for (int s = 0; s < 8; s++) edgeOffsets[s] = clockEdgeA.offset;
+            }
+            if (clockEdgeB.process(clockBVoltage)) {
+                edges |= localSeqs << 8;
+                for (int s = 0; s < 8; s++) edgeOffsets[8 + s] = clockEdgeB.offset;
+            }
+        }
+        if (expanderSeqs) {
+            uint16_t expanderEdges = clockMsg->risingEdges & (expanderSeqs | (expanderSeqs << 8));
+            // The expander detected these edges on its previous frame (the message
+            // reaches us through the expander flip), so they are one sample older
+            for (int i = 0; i < 16; i++) {
+                if (expanderEdges & (1 << i)) edgeOffsets[i] = clockMsg->edgeOffsets[i] + 1.f;
+            }
+            edges |= expanderEdges;
+        }
 
         // Track if any clock rose (for LED updates)
-        bool anyClockARose = false;
-        bool anyClockBRose = false;
-
-        // Process clock inputs for all sequencers
-        for (int s = 0; s < 8; s++) {
-            Sequencer& seq = sequencers[s];
-
-            // Determine clock sources for this sequencer
-            float clockAVoltage, clockBVoltage;
-            if (hasClockExpander && clockMsg->hasClockA[s]) {
-                // Use per-sequencer clocks from expander
-                clockAVoltage = clockMsg->clockA[s];
-                clockBVoltage = clockMsg->hasClockB[s] ? clockMsg->clockB[s] : clockAVoltage;
-            } else {
-                // Fall back to module's shared clock inputs
-                clockAVoltage = defaultClockAVoltage;
-                clockBVoltage = defaultClockBVoltage;
+        bool anyClockARose = (edges & 0x00FF) != 0;
+        bool anyClockBRose = (edges & 0xFF00) != 0;
+
+        // Advance only the sequencers that received an edge
+        uint8_t clockedSeqs = (edges | (edges >> 8)) & 0xFF;
+        for (int s = 0; clockedSeqs; s++, clockedSeqs >>= 1) {
+            if (!(clockedSeqs & 1)) continue;
+            bool clockARose = edges & (1 << s);
+            bool clockBRose = edges & (1 << (8 + s));
+
+            // Estimated (sub-sample) edge times
+            double edgeA = args.frame - edgeOffsets[s];
+            double edgeB = args.frame - edgeOffsets[8 + s];
+            if (clockARose) {
+                clockPredictorA[s].edge(edgeA);
+            }
+            if (clockBRose) {
+                clockPredictorB[s].edge(edgeB);
             }
 
-            // Process triggers per-sequencer
-            bool clockARose = perSeqClockTriggerA[s].process(clockAVoltage);
-            bool clockBRose = perSeqClockTriggerB[s].process(clockBVoltage);
-
-            if (clockARose) anyClockARose = true;
-            if (clockBRose) anyClockBRose = true;
+            // Queued pattern switches happen on the clock that restarts the loop
+            if (engine.isPatternSwitchDue(s, clockARose)) {
+                engine.switchToQueuedPattern(s, knobValues[s + 1]);
+                onPatternLoaded(s);
+            }
 
-            if (seq.isStepSingleMode()) {
-                // Single step mode: only use Clock A
-                if (clockARose) {
-                    processSequencerClockSingle(s);
-                }
-            } else {
-                // Dual step mode: Clock A for Seq A, Clock B for Seq B
-                if (clockARose) {
-                    processSequencerClockDualA(s);
+            ClockResult fired = engine.processClock(s, clockARose, clockBRose);
+            const Sequencer& seq = engine.sequencers[s];
+            // Triggers are scheduled at the estimated clock edge
+            if (fired.fireA) {
+                scheduleStepTriggers(s, 0, edgeA, clockPredictorA[s], seq.currentStepA);
+            }
+            if (fired.fireB) {
+                // Single mode routes clock A to output B
+                if (seq.isStepSingleMode()) {
+                    scheduleStepTriggers(s, 1, edgeA, clockPredictorA[s], seq.currentStepA);
+                } else {
+                    scheduleStepTriggers(s, 1, edgeB, clockPredictorB[s], seq.currentStepB);
                 }
-                if (clockBRose) {
-                    processSequencerClockDualB(s);
+            }
+            if (fired.echoA) {
+                scheduleTrigger(s, 0, edgeA, 1e-3f);
+            }
+            if (fired.echoB) {
+                scheduleTrigger(s, 1, edgeB, 1e-3f);
+            }
+        }
+
+        // Start all triggers/gates that are due. The pulse is shortened only by the
+        // sub-sample part of it that already elapsed before this sample: events due
+        // further back (a MIDI tick filtered to an earlier time) keep their length.
+        for (int s = 0; s < 8; s++) {
+            ScheduledEvent event;
+            while (eventQueues[s].popDue(args.frame, &event)) {
+                float late = args.frame - event.time;
+                float length = event.length - std::min(late, 1.f) * args.sampleTime;
+                if (event.output == 0) {
+                    trigPulseA[s].trigger(length);
+                    seqTriggeredAThisFrame[s] = true;
+                    seqTriggerOffsetA[s] = std::min(late, 1.f);
+                    seqTriggerLengthA[s] = event.length;
+                } else {
+                    trigPulseB[s].trigger(length);
+                    seqTriggeredBThisFrame[s] = true;
+                    seqTriggerOffsetB[s] = std::min(late, 1.f);
+                    seqTriggerLengthB[s] = event.length;
                 }
             }
         }
 
-        // Update LEDs if viewing a sequencer and clock happened (skip if holding Device/RecArm)
-        if (currentLayout > 0 && (anyClockARose || anyClockBRose) && !deviceButtonHeld && !recArmHeld) {
-            updateSequencerLEDs();
+        // Update LEDs if viewing a sequencer and clock happened (skip while a button overlay is shown)
+        // Only the old and new playhead LEDs are redrawn
+        if (currentLayout > 0 && (anyClockARose || anyClockBRose) && !isOverlayShown()) {
+            renderSequencerLEDs();
+        } else if (ledLookahead > 0.f && currentLayout > 0 && !isOverlayShown()) {
+            // Pre-render the upcoming playhead when a predicted edge enters the lookahead
+            // window, and fall back to the real state when a prediction is missed
+            int s = currentLayout - 1;
+            if (isLookaheadDue(s, false) != lookaheadDueA || isLookaheadDue(s, true) != lookaheadDueB) {
+                renderSequencerLEDs();
+            }
         }
 
         // Process all pulse generators
@@ -425,40 +477,19 @@ struct Core : Module {
         // CPU optimization: only compute slewed CV for sequencers that need it
         // - Always compute for the output sequencer (outSeq)
         // - Compute for all 8 only if there's a right expander that might use them
-        bool hasRightExpander = rightExpander.module != nullptr;
+        bool hasRightExpander = isChainExpander(rightExpander.module);
         for (int s = 0; s < 8; s++) {
             // Skip if not needed: no right expander AND not the output sequencer
             if (!hasRightExpander && (s + 1) != outSeq) continue;
 
-            Sequencer& seq = sequencers[s];
-            int layout = s + 1;  // Layout index (1-8)
-
-            // Compute target CV A
-            int knobIdxA = seq.currentValueIndexA;
-            int glideValA = seq.glideTime[knobIdxA];
-            if (glideValA == 0) {
-                // Fast path: no glide, direct assignment
-                seq.currentSlewA = knobToVoltage(knobValues[layout][knobIdxA], seq.voltageRangeA, seq.bipolarA);
+            if (morphFader >= 0 && s + 1 == morphSequencer) {
+                engine.processSlew(s, morphKnobs, args.sampleTime);
             } else {
-                float targetA = knobToVoltage(knobValues[layout][knobIdxA], seq.voltageRangeA, seq.bipolarA);
-                float glideTimeA = (glideValA / 127.f) * 3.f;
-                seq.currentSlewA = applySlewExp(seq.currentSlewA, targetA, glideTimeA, args.sampleTime);
-            }
-
-            // Compute target CV B
-            int knobIdxB = seq.isValueSingleMode() ? seq.currentValueIndexA : (8 + seq.currentValueIndexB);
-            int glideValB = seq.glideTime[knobIdxB];
-            if (glideValB == 0) {
-                // Fast path: no glide, direct assignment
-                seq.currentSlewB = knobToVoltage(knobValues[layout][knobIdxB], seq.voltageRangeB, seq.bipolarB);
-            } else {
-                float targetB = knobToVoltage(knobValues[layout][knobIdxB], seq.voltageRangeB, seq.bipolarB);
-                float glideTimeB = (glideValB / 127.f) * 3.f;
-                seq.currentSlewB = applySlewExp(seq.currentSlewB, targetB, glideTimeB, args.sampleTime);
+                engine.processSlew(s, knobValues[s + 1], args.sampleTime);
             }
         }
         if (outSeq > 0) {
-            Sequencer& seq = sequencers[outSeq - 1];
+            Sequencer& seq = engine.sequencers[outSeq - 1];
 
             // Output triggers and slewed CV (slew already computed above for all sequencers)
             outputs[SEQ_TRIG_A_OUTPUT].setVoltage(trigOutA[outSeq - 1] ? 10.f : 0.f);
@@ -473,317 +504,555 @@ struct Core : Module {
             outputs[SEQ_CV_B_OUTPUT].setVoltage(0.f);
         }
 
-        // Set connected light based on MIDI input device
-        bool midiConnected = midiInput.getDeviceId() >= 0;
-        lights[CONNECTED_LIGHT].setBrightness(midiConnected ? 1.f : 0.f);
-
-        // Takeover light - stays on once takeover happens
-        lights[TAKEOVER_LIGHT].setBrightness(takenOver ? 1.f : 0.f);
-
         // Update and send expander message to right-side expanders
         // CPU optimization: only update if there's a right expander
-        if (rightExpander.module) {
+        if (isChainExpander(rightExpander.module)) {
             updateExpanderMessage();
-            LCXLExpanderMessage* msg = reinterpret_cast<LCXLExpanderMessage*>(rightExpander.module->leftExpander.producerMessage);
-            if (msg) {
-                *msg = expanderMessage;
-                rightExpander.module->leftExpander.messageFlipRequested = true;
-            }
+            sendSnapshot(rightExpander.module, snapshot);
+        }
+
+        // Send the LED changes queued by this frame
+        if (device && ledQueue.dirty) {
+            device->flush(ledQueue, deviceTemplate, midiOutput);
         }
 
         // Reset trigger flags for next frame
         for (int s = 0; s < 8; s++) {
             seqTriggeredAThisFrame[s] = false;
             seqTriggeredBThisFrame[s] = false;
+            seqTriggerOffsetA[s] = 0.f;
+            seqTriggerOffsetB[s] = 0.f;
         }
     }
 
-    // Single mode clock processing: one sequencer, routing to A or B
-    void processSequencerClockSingle(int seqIndex) {
-        Sequencer& seq = sequencers[seqIndex];
+    // Apply the MOD inputs. Every sample, the modulated values of all 8 sequencers
+    // are computed and kept in float_4 lanes; a sequencer is only written for lanes
+    // whose value changed. Lengths go through the engine (which resets playheads past
+    // the end), so they only cost anything when their quantized value changes.
+    void processModulation() {
+        for (int m = 0; m < NUM_MODS; m++) {
+            Input& input = inputs[MOD_BIAS_INPUT + m];
+            if (!input.isConnected()) {
+                if (modConnected[m]) endModulation(m);
+                continue;
+            }
+            modConnected[m] = true;
 
-        // Advance step
-        seq.currentStepA = (seq.currentStepA + 1) % seq.stepLengthA;
+            // A mono cable modulates all 8 sequencers
+            simd::float_4 volts[2];
+            if (input.getChannels() == 1) {
+                volts[0] = volts[1] = input.getVoltage();
+            } else {
+                volts[0] = input.getVoltageSimd<simd::float_4>(0);
+                volts[1] = input.getVoltageSimd<simd::float_4>(4);
+            }
 
-        // Check if step is active
-        if (!seq.steps[seq.currentStepA]) return;
+            switch (m) {
+                case 0: modulateBias(volts); break;
+                case 1: modulateLengths(0, volts); break;
+                case 2: modulateLengths(1, volts); break;
+                case 3:  // CV offset in knob steps
+                    for (int i = 0; i < 2; i++) {
+                        (volts[i] * 12.7f).store(&cvOffsets[i * 4]);
+                    }
+                    break;
+                case 4:  // Density offset, applied by the engine on each clock
+                    modulateDensity(volts);
+                    break;
+            }
+        }
+    }
 
-        // Advance value index
-        seq.currentValueIndexA = (seq.currentValueIndexA + 1) % seq.valueLengthA;
+    // Store the lanes of `values` that differ from `last` in `last`, and return
+    // them as a bit per sequencer
+    static int updateLanes(const simd::float_4* values, float* last) {
+        int changed = 0;
+        for (int i = 0; i < 2; i++) {
+            changed |= simd::movemask(values[i] != simd::float_4::load(&last[i * 4])) << (i * 4);
+            values[i].store(&last[i * 4]);
+        }
+        return changed;
+    }
 
-        // Determine routing destination
-        bool fireA = false, fireB = false;
+    // Bias knob (0-127) plus 12.7 steps per volt
+    void modulateBias(const simd::float_4* volts) {
+        if (knobRevision != modBiasRevision) {
+            // A knob, pattern load or undo may have set the bias: set every lane again
+            modBiasRevision = knobRevision;
+            for (int s = 0; s < 8; s++) {
+                modBiasBase[s] = knobValues[s + 1][20];
+                modBias[s] = -1.f;
+            }
+        }
+        simd::float_4 bias[2];
+        for (int i = 0; i < 2; i++) {
+            simd::float_4 knob = simd::float_4::load(&modBiasBase[i * 4]) + volts[i] * 12.7f;
+            bias[i] = simd::clamp(knob, 0.f, 127.f) * (1.f / 127.f);
+        }
+        int changed = updateLanes(bias, modBias);
+        for (int s = 0; changed; s++, changed >>= 1) {
+            if (changed & 1) engine.sequencers[s].bias = modBias[s];
+        }
+    }
 
-        switch (seq.routingMode) {
-            case ROUTE_ALL_A:
-                fireA = true;
-                break;
-            case ROUTE_ALL_B:
-                fireB = true;
-                break;
-            case ROUTE_BERNOULLI:
-                if (random::uniform() < seq.bias) fireB = true;
-                else fireA = true;
-                break;
-            case ROUTE_ALTERNATE:
-                if (seq.alternateCounter % 2 == 0) fireA = true;
-                else fireB = true;
-                seq.alternateCounter++;
-                break;
-            case ROUTE_TWO_TWO:
-                if ((seq.alternateCounter / 2) % 2 == 0) fireA = true;
-                else fireB = true;
-                seq.alternateCounter++;
-                break;
-            case ROUTE_BURST: {
-                // Random bursts - bias controls probability of switching
-                static bool burstToA = true;
-                if (random::uniform() < seq.bias * 0.3f) burstToA = !burstToA;
-                if (burstToA) fireA = true;
-                else fireB = true;
-                break;
+    // 0.1 density per volt
+    void modulateDensity(const simd::float_4* volts) {
+        simd::float_4 offsets[2] = {volts[0] * 0.1f, volts[1] * 0.1f};
+        int changed = updateLanes(offsets, modDensity);
+        for (int s = 0; changed; s++, changed >>= 1) {
+            if (changed & 1) engine.sequencers[s].densityOffset = modDensity[s];
+        }
+    }
+
+    // Step (which = 0) or value (1) length A plus 1.5 steps per volt (10V = the full
+    // 1-16 range of one page). The lengths are only re-read when the engine's length
+    // revision moved: a length that differs from what modulation last set was changed
+    // by a knob, pattern load or undo, and becomes the new unmodulated length.
+    void modulateLengths(int which, const simd::float_4* volts) {
+        if (engine.lengthRevision != modLengthRevision[which]) {
+            modLengthRevision[which] = engine.lengthRevision;
+            for (int s = 0; s < 8; s++) {
+                const Sequencer& seq = engine.sequencers[s];
+                float current = which == 0 ? seq.stepLengthA : seq.valueLengthA;
+                if (current != modLengths[which][s]) {
+                    modLengthBase[which][s] = current;
+                    modLengths[which][s] = 0.f;  // Set the modulated length again
+                }
+                modMaxLength[which][s] = which == 0 ? 16 * seq.pages : 16;
             }
-            case ROUTE_PROBABILITY:
-                if (random::uniform() < seq.bias) fireB = true;
-                else fireA = true;
-                break;
-            case ROUTE_PATTERN:
-                // Odd steps to A, even to B
-                if (seq.currentStepA % 2 == 0) fireA = true;
-                else fireB = true;
-                break;
         }
 
-        if (fireA) {
-            trigPulseA[seqIndex].trigger(1e-3f);
-            seqTriggeredAThisFrame[seqIndex] = true;
+        simd::float_4 lengths[2];
+        for (int i = 0; i < 2; i++) {
+            simd::float_4 base = simd::float_4::load(&modLengthBase[which][i * 4]);
+            simd::float_4 length = simd::floor(base + volts[i] * 1.5f + 0.5f);
+            lengths[i] = simd::clamp(length, simd::float_4(1.f), simd::float_4::load(&modMaxLength[which][i * 4]));
         }
-        if (fireB) {
-            trigPulseB[seqIndex].trigger(1e-3f);
-            seqTriggeredBThisFrame[seqIndex] = true;
+        int changed = updateLanes(lengths, modLengths[which]);
+        for (int s = 0; changed; s++, changed >>= 1) {
+            if (changed & 1) setLengthA(s, which, (int) modLengths[which][s]);
         }
     }
 
-    // Dual mode clock A processing: Seq A step
-    void processSequencerClockDualA(int seqIndex) {
-        Sequencer& seq = sequencers[seqIndex];
+    // Set step/value length A through the engine, from the knob value that gives it
+    void setLengthA(int s, int which, int length) {
+        int maxLength = which == 0 ? 16 * engine.sequencers[s].pages : 16;
+        int knob = ((length - 1) * 127 + maxLength - 2) / (maxLength - 1);  // Smallest knob value mapping to length
+        if (which == 0) engine.setStepLengthA(s, knob);
+        else engine.setValueLengthA(s, knob);
+        if (s + 1 == currentLayout) {
+            markLengthLEDs(which == 0 ? 2 : 0, engine.sequencers[s]);
+        }
+    }
 
-        // Advance step A
-        seq.currentStepA = (seq.currentStepA + 1) % seq.stepLengthA;
+    // MOD cable removed: back to the unmodulated values
+    void endModulation(int m) {
+        modConnected[m] = false;
+        for (int s = 0; s < 8; s++) {
+            switch (m) {
+                case 0:
+                    engine.setBias(s, knobValues[s + 1][20]);
+                    modBiasRevision = knobRevision - 1;  // Re-read the knobs when reconnected
+                    break;
+                case 1:
+                case 2: {
+                    int which = m - 1;
+                    const Sequencer& seq = engine.sequencers[s];
+                    int current = which == 0 ? seq.stepLengthA : seq.valueLengthA;
+                    // Unless something else changed the length since, restore the unmodulated one
+                    if (current == (int) modLengths[which][s] && current != (int) modLengthBase[which][s]) {
+                        setLengthA(s, which, (int) modLengthBase[which][s]);
+                    }
+                    modLengths[which][s] = 0.f;
+                    modLengthRevision[which] = engine.lengthRevision - 1;  // Re-read the lengths when reconnected
+                    break;
+                }
+                case 3:
+                    cvOffsets[s] = 0.f;
+                    break;
+                case 4:
+                    engine.sequencers[s].densityOffset = 0.f;
+                    modDensity[s] = 0.f;
+                    break;
+            }
+        }
+    }
 
-        // Check if step is active (top row buttons = steps 0-7)
-        if (!seq.steps[seq.currentStepA]) return;
+    // After a sequencer's pattern (and its layout's knob values) was replaced
+    void onPatternLoaded(int s) {
+        int layout = s + 1;
+        knobRevision++;
+        journal.removeLayout(layout);  // Its journaled edits belong to the pattern that was replaced
+        if (generatorLayout == layout) generatorEdit = false;
+        for (int i = 0; i < 24; i++) {
+            knobPickedUp[layout][i] = false;  // Stored values moved away from the knobs
+        }
+        if (layout == currentLayout) {
+            if (muteHeld) {
+                showPatternBankLEDs();
+            } else {
+                dirtyLEDs |= ALL_SEQUENCER_LEDS;  // Drawn with the clock's LED update
+            }
+        }
+        recordChange(CHANGE_PATTERN, layout, engine.banks[s].active + 1, 0);
+    }
 
-        // Check for competition with B
-        bool aWantsToFire = true;
-        bool bWantsToFire = (seq.stepLengthB > 0) && seq.steps[8 + (seq.currentStepB % seq.stepLengthB)];
+    // Non-audio work, called every controlRateDivision frames
+    void processControlRate(const ProcessArgs& args) {
+        // Check if any amber timer has expired and needs LED update (skip while a button overlay is shown)
+        if (currentLayout > 0 && !isOverlayShown()) {
+            bool needsUpdate = false;
+            for (int i = 0; i < 4; i++) {
+                if (lengthChangeTime[i] >= 0) {
+                    float elapsed = currentTime - lengthChangeTime[i];
+                    if (elapsed >= AMBER_DISPLAY_TIME) {
+                        lengthChangeTime[i] = -1.f;  // Clear the expired timer
+                        markLengthLEDs(i, engine.sequencers[currentLayout - 1]);
+                        needsUpdate = true;
+                    }
+                }
+            }
+            if (needsUpdate || dirtyLEDs) {  // dirtyLEDs: lengths changed by modulation
+                renderSequencerLEDs();
+            }
+        }
 
-        bool aWins = resolveCompetition(seq, aWantsToFire, bWantsToFire, true);
+        // Check for MIDI output device connection change - auto-initialize
+        int currentMidiOutputId = midiOutput.getDeviceId();
+        if (currentMidiOutputId >= 0 && currentMidiOutputId != lastMidiOutputDeviceId) {
+            lastMidiOutputDeviceId = currentMidiOutputId;
+            device = LCXLDevice::acquire(midiOutput.getDriverId(), currentMidiOutputId);
+            initializeDevice();
+        } else if (currentMidiOutputId < 0 && lastMidiOutputDeviceId >= 0) {
+            // Device disconnected
+            lastMidiOutputDeviceId = -1;
+            device.reset();
+            takenOver = false;
+            resyncPosition = LCXLDevice::NUM_LEDS;
+        }
 
-        if (aWins) {
-            // A fires - advance value index
-            seq.currentValueIndexA = (seq.currentValueIndexA + 1) % seq.valueLengthA;
-            trigPulseA[seqIndex].trigger(1e-3f);
-            seqTriggeredAThisFrame[seqIndex] = true;
+        if (device) {
+            // Another Core forced its template, or the user selected another one on the controller
+            int selected = device->selectedTemplate;
+            if (takenOver && selected >= 0 && selected != deviceTemplate) {
+                takenOver = false;
+            }
+            if (resyncPosition < LCXLDevice::NUM_LEDS) {
+                stepResync();
+            }
         }
-    }
 
-    // Dual mode clock B processing: Seq B step
-    void processSequencerClockDualB(int seqIndex) {
-        Sequencer& seq = sequencers[seqIndex];
+        // Check takeover button using trigger for edge detection
+        if (takeoverTrigger.process(params[TAKEOVER_PARAM].getValue() > 0.f)) {
+            if (!takenOver) {
+                performTakeover();
+            }
+        }
+
+        // Process incoming MIDI messages received up to this frame
+        midi::Message msg;
+        while (midiInput.tryPop(&msg, args.frame)) {
+            processMidiMessage(msg);
+        }
 
-        // B disabled if length is 0
-        if (seq.stepLengthB <= 0) return;
+        // Undo/redo requested from the menu
+        for (int n = undoRequests.exchange(0); n > 0; n--) undoEdit();
+        for (int n = redoRequests.exchange(0); n > 0; n--) redoEdit();
 
-        // Advance step B
-        seq.currentStepB = (seq.currentStepB + 1) % seq.stepLengthB;
+        // Output fader CVs (always active, held between control-rate updates)
+        for (int i = 0; i < 8; i++) {
+            float voltage = faderValues[i] / 127.f * 10.f;
+            outputs[FADER_OUTPUT_1 + i].setVoltage(voltage);
+        }
 
-        // Check if step is active (bottom row buttons = steps 8-15)
-        if (!seq.steps[8 + seq.currentStepB]) return;
+        // Recompute the layout morph only when the fader or a source knob moved
+        if (morphFader >= 0 && (faderValues[morphFader] != lastMorphFader || knobRevision != morphRevision)) {
+            updateMorph();
+        }
 
-        // Check for competition with A
-        bool aWantsToFire = seq.steps[seq.currentStepA % seq.stepLengthA];
-        bool bWantsToFire = true;
+        // Set connected light based on MIDI input device
+        bool midiConnected = midiInput.getDeviceId() >= 0;
+        lights[CONNECTED_LIGHT].setBrightness(midiConnected ? 1.f : 0.f);
 
-        bool bWins = !resolveCompetition(seq, aWantsToFire, bWantsToFire, false);
+        // Takeover light - stays on once takeover happens
+        lights[TAKEOVER_LIGHT].setBrightness(takenOver ? 1.f : 0.f);
+    }
 
-        if (bWins) {
-            // B fires - advance value index
-            if (seq.valueLengthB > 0) {
-                seq.currentValueIndexB = (seq.currentValueIndexB + 1) % seq.valueLengthB;
+    // Handle the MIDI clock and transport messages due by this frame, each at the
+    // frame it was received on. Start parks the playheads of `seqs`, so the first
+    // tick plays their first step. Returns the sequencers of `seqs` whose step a
+    // tick completes, setting offsets[s] to the frames by which the filtered time of
+    // sequencer s's tick lies before this frame.
+    uint8_t processClockInput(int64_t frame, uint8_t seqs, float offsets[8]) {
+        uint8_t stepped = 0;
+        midi::Message msg;
+        while (clockInput.tryPop(&msg, frame)) {
+            if (msg.getStatus() != 0xf) continue;
+            switch (msg.getChannel()) {
+                case 0x8: {  // Timing clock
+                    double tick;
+                    uint8_t tickSeqs = midiClock.tick(msg.getFrame() >= 0 ? msg.getFrame() : frame, engine.sequencers, &tick);
+                    for (int s = 0; s < 8; s++) {
+                        if (tickSeqs & (1 << s)) offsets[s] = frame - tick;
+                    }
+                    stepped |= tickSeqs;
+                    break;
+                }
+                case 0xa:  // Start
+                    midiClock.start();
+                    for (int s = 0; s < 8; s++) {
+                        if (!(seqs & (1 << s))) continue;
+                        eventQueues[s].clear();
+                        if (engine.banks[s].queued >= 0) {
+                            engine.switchToQueuedPattern(s, knobValues[s + 1]);
+                            onPatternLoaded(s);
+                        } else {
+                            engine.parkPlayheads(s);
+                        }
+                    }
+                    if (currentLayout > 0 && !isOverlayShown()) {
+                        renderSequencerLEDs();
+                    }
+                    break;
+                case 0xb:  // Continue
+                    midiClock.resume();
+                    break;
+                case 0xc:  // Stop
+                    midiClock.stop();
+                    break;
             }
-            trigPulseB[seqIndex].trigger(1e-3f);
-            seqTriggeredBThisFrame[seqIndex] = true;
         }
+        return stepped & seqs;
     }
 
-    // Resolve competition between A and B, returns true if A wins
-    bool resolveCompetition(Sequencer& seq, bool aWants, bool bWants, bool isAClock) {
-        // If only one wants to fire, they win
-        if (aWants && !bWants) return true;
-        if (bWants && !aWants) return false;
-        if (!aWants && !bWants) return isAClock;  // Neither wants, default
-
-        // Both want to fire - competition!
-        switch (seq.competitionMode) {
-            case COMP_INDEPENDENT:
-                // Both can fire - let each win on their own clock
-                return isAClock;  // A wins on A's clock, B wins on B's clock
+    // Interpolate all 24 knobs between the two morph layouts, 4 at a time
+    void updateMorph() {
+        lastMorphFader = faderValues[morphFader];
+        morphRevision = knobRevision;
+        morphKnobsRevision++;
+
+        simd::float_4 t = lastMorphFader / 127.f;
+        const int* from = knobValues[morphFrom];
+        const int* to = knobValues[morphTo];
+        for (int i = 0; i < 24; i += 4) {
+            simd::float_4 a = simd::int32_4::load(&from[i]);
+            simd::float_4 b = simd::int32_4::load(&to[i]);
+            simd::float_4 out = a + (b - a) * t;
+            out.store(&morphKnobs[i]);
+        }
+    }
 
-            case COMP_STEAL:
-                // Bernoulli decides
-                return random::uniform() >= seq.bias;
+    // Change morph settings (from the UI thread); the morph is recomputed at control rate
+    void setMorph(int fader, int from, int to, int sequencer) {
+        morphFrom = from;
+        morphTo = to;
+        morphSequencer = sequencer;
+        lastMorphFader = -1;
+        morphFader = fader;
+    }
 
-            case COMP_A_PRIORITY:
-                // A wins if bias is high enough
-                return random::uniform() < (0.5f + seq.bias * 0.5f);
+    // Queue a trigger/gate on output 0 (A) or 1 (B) of sequencer s
+    void scheduleTrigger(int s, int output, double time, float length) {
+        ScheduledEvent event;
+        event.time = time;
+        event.length = length;
+        event.output = output;
+        eventQueues[s].push(event);  // Dropped if the queue is full
+    }
 
-            case COMP_B_PRIORITY:
-                // B wins if bias is high enough
-                return random::uniform() >= (0.5f + seq.bias * 0.5f);
+    // Schedule the trigger(s) of a fired step on output 0 (A) or 1 (B).
+    // Swing, ratchets and gate length are relative to the clock period, so they
+    // only apply once the clock's period is known.
+    void scheduleStepTriggers(int s, int output, double edgeTime, const ClockPredictor& clock, int step) {
+        const Sequencer& seq = engine.sequencers[s];
+        double period = clock.period;
+        if (period <= 0.0) {
+            scheduleTrigger(s, output, edgeTime, 1e-3f);
+            return;
+        }
 
-            case COMP_MOMENTUM: {
-                // Winner gets boost next time
-                bool aWins = random::uniform() < seq.momentumA;
-                if (aWins) {
-                    seq.momentumA = std::min(1.0f, seq.momentumA + seq.bias * 0.2f);
-                    seq.momentumB = std::max(0.0f, seq.momentumB - seq.bias * 0.1f);
-                } else {
-                    seq.momentumB = std::min(1.0f, seq.momentumB + seq.bias * 0.2f);
-                    seq.momentumA = std::max(0.0f, seq.momentumA - seq.bias * 0.1f);
-                }
-                return aWins;
-            }
+        // Swing delays every odd step (MPC style: 0.5 = straight)
+        double start = edgeTime;
+        if (step % 2 == 1) {
+            start += (2.f * seq.swing - 1.f) * period;
+        }
 
-            case COMP_REVENGE: {
-                // Loser gets boost next time
-                bool aWins;
-                if (seq.lastWinnerA) {
-                    // B has revenge chance
-                    aWins = random::uniform() >= seq.bias * 0.7f;
-                } else {
-                    // A has revenge chance
-                    aWins = random::uniform() < (1.0f - seq.bias * 0.7f);
-                }
-                seq.lastWinnerA = aWins;
-                return aWins;
-            }
+        int ratchets = std::max(1, seq.ratchets);
+        double spacing = period / ratchets;
+        float length = 1e-3f;
+        if (seq.gateLength > 0.f) {
+            length = seq.gateLength * spacing / sampleRate;
+        }
+        for (int r = 0; r < ratchets; r++) {
+            scheduleTrigger(s, output, start + r * spacing, length);
+        }
+    }
 
-            case COMP_ECHO:
-                // Winner fires, loser echoes on next clock
-                if (isAClock) {
-                    bool aWins = random::uniform() >= seq.bias;
-                    if (!aWins) seq.pendingEchoA = true;
-                    return aWins;
-                } else {
-                    bool bWins = random::uniform() < seq.bias;
-                    if (!bWins) seq.pendingEchoB = true;
-                    return !bWins;
-                }
+    // Whether a predicted clock edge for sequencer s is inside the LED lookahead window
+    bool isLookaheadDue(int s, bool clockB) {
+        if (ledLookahead <= 0.f) return false;
+        if (clockB && engine.sequencers[s].isStepSingleMode()) return false;  // Single mode ignores clock B
+        double window = ledLookahead * sampleRate;
+        ClockPredictor& predictor = clockB ? clockPredictorB[s] : clockPredictorA[s];
+        return predictor.isEdgeDue(currentFrame, window);
+    }
 
-            case COMP_VALUE_THEFT:
-                // Winner uses combined CV - handled in output stage
-                return random::uniform() >= seq.bias;
-        }
+    // Step page the buttons show for sequencer s. Paging only applies in single
+    // step mode; dual mode always shows page 0 (A on top, B below).
+    int shownPage(int s) {
+        const Sequencer& seq = engine.sequencers[s];
+        return seq.isStepSingleMode() ? std::min(viewPage[s], seq.pages - 1) : 0;
+    }
 
-        return true;  // Default A wins
+    // Sequencer state to show on the LEDs: the viewed sequencer, advanced by any
+    // clock edge predicted within the lookahead window
+    const Sequencer& ledSequencer() {
+        int s = currentLayout - 1;
+        lookaheadDueA = isLookaheadDue(s, false);
+        lookaheadDueB = isLookaheadDue(s, true);
+        if (!lookaheadDueA && !lookaheadDueB) {
+            return engine.sequencers[s];
+        }
+        ledPreview = engine.sequencers[s];
+        SequencerEngine::previewClock(ledPreview, lookaheadDueA, lookaheadDueB);
+        return ledPreview;
     }
 
-    // Update LED display for current sequencer
+    // Update LED display for current sequencer (full repaint)
     void updateSequencerLEDs() {
+        dirtyLEDs |= ALL_SEQUENCER_LEDS;
+        renderSequencerLEDs();
+    }
+
+    void markLED(int ledIndex) {
+        dirtyLEDs |= 1ull << ledIndex;
+    }
+
+    // Step buttons 0-15 are LEDs 24-39 (Track Focus, then Track Control)
+    void markStepLED(int stepIndex) {
+        markLED(24 + stepIndex);
+    }
+
+    // Mark the LEDs a length change can affect: its row (both rows in single mode)
+    void markLengthLEDs(int lengthParamIndex, const Sequencer& seq) {
+        switch (lengthParamIndex) {
+            case 0: dirtyLEDs |= seq.isValueSingleMode() ? 0xFFFFull : 0x00FFull; break;  // Value knobs A
+            case 1: dirtyLEDs |= 0xFF00ull; break;                                           // Value knobs B
+            case 2: dirtyLEDs |= seq.isStepSingleMode() ? 0xFFFFull << 24 : 0x00FFull << 24; break;  // Steps A
+            case 3: dirtyLEDs |= 0xFF00ull << 24; break;                                     // Steps B
+        }
+    }
+
+    // Render only the LEDs marked dirty, plus the old and new playhead positions.
+    // A clock edge usually changes 2-4 LEDs instead of all 40.
+    void renderSequencerLEDs() {
         if (currentLayout <= 0) return;
+        if (isOverlayShown()) return;  // Repainted when the overlay button is released
 
-        Sequencer& seq = sequencers[currentLayout - 1];
+        const Sequencer& seq = ledSequencer();
 
-        // Steps and values can have independent single/dual modes
-        // Step buttons
+        // Playhead LEDs: step A, step B, value A, value B (-1 = none)
+        int playheads[4];
         if (seq.isStepSingleMode()) {
-            for (int i = 0; i < 16; i++) {
-                updateStepLEDSingle(i, seq);
-            }
+            int button = seq.currentStepA - 16 * shownPage(currentLayout - 1);
+            playheads[0] = (button >= 0 && button < 16) ? 24 + button : -1;  // Only on the shown page
+            playheads[1] = -1;
         } else {
-            for (int i = 0; i < 8; i++) {
-                updateStepLEDDual(i, seq, true);
-                updateStepLEDDual(8 + i, seq, false);
-            }
+            playheads[0] = 24 + seq.currentStepA;
+            playheads[1] = (seq.stepLengthB > 0) ? 32 + seq.currentStepB : -1;
         }
-
-        // Value knobs
         if (seq.isValueSingleMode()) {
-            updateValueKnobLEDsSingle(seq);
+            playheads[2] = seq.currentValueIndexA;
+            playheads[3] = -1;
         } else {
-            updateValueKnobLEDsDual(seq);
-        }
-
-        for (int i = 16; i < 24; i++) {
-            updateKnobLED(i);
+            playheads[2] = seq.currentValueIndexA;
+            playheads[3] = (seq.valueLengthB > 0) ? 8 + seq.currentValueIndexB : -1;
+        }
+        for (int i = 0; i < 4; i++) {
+            if (playheads[i] == shownPlayheads[i]) continue;
+            if (shownPlayheads[i] >= 0) markLED(shownPlayheads[i]);
+            if (playheads[i] >= 0) markLED(playheads[i]);
+            shownPlayheads[i] = playheads[i];
+        }
+
+        uint64_t dirty = dirtyLEDs & ALL_SEQUENCER_LEDS;
+        dirtyLEDs = 0;
+        for (int led = 0; dirty; led++, dirty >>= 1) {
+            if (!(dirty & 1)) continue;
+            if (led < 24) {
+                sendKnobLEDSysEx(led, sequencerKnobColor(led, seq));
+            } else {
+                sendButtonLEDSysEx(led - 24, sequencerStepColor(led - 24, seq));
+            }
         }
     }
 
-    void updateStepLEDSingle(int stepIndex, const Sequencer& seq) {
-        bool showAmber = shouldShowAmber(2);  // stepLengthA timer
-        bool isPlayhead = (stepIndex == seq.currentStepA);
-        bool isActive = seq.steps[stepIndex];
+    // Color of a step button in the sequencer view
+    uint8_t sequencerStepColor(int stepIndex, const Sequencer& seq) {
+        int step = stepIndex + 16 * shownPage(currentLayout - 1);
+        int localStep = step;
+        int stepLength = seq.stepLengthA;
+        int currentStep = seq.currentStepA;
+        int amberIndex = 2;  // stepLengthA timer
+        if (!seq.isStepSingleMode() && stepIndex >= 8) {
+            localStep = stepIndex - 8;
+            stepLength = seq.stepLengthB;
+            currentStep = seq.currentStepB;
+            amberIndex = 3;  // stepLengthB timer
+        }
 
-        uint8_t color;
-        if (stepIndex >= seq.stepLengthA) {
-            color = LCXL::LED_OFF;  // Out of range
-        } else if (showAmber && stepIndex == seq.stepLengthA - 1) {
-            // Boundary marker (only while adjusting)
-            color = LCXL::LED_AMBER_FULL;
-        } else if (isPlayhead && isActive) {
-            color = LCXL::LED_GREEN_FULL;  // Playhead on active step: bright green
-        } else if (isPlayhead) {
-            color = LCXL::LED_RED_LOW;  // Playhead on inactive step: dim red
-        } else if (isActive) {
-            color = LCXL::LED_GREEN_LOW;  // Active step: dim green
-        } else {
-            color = LCXL::LED_OFF;  // Inactive step
+        if (localStep >= stepLength) {
+            return LCXL::LED_OFF;  // Out of range or seq B disabled
+        }
+        if (localStep == stepLength - 1 && shouldShowAmber(amberIndex)) {
+            return LCXL::LED_AMBER_FULL;  // Boundary marker (only while adjusting)
         }
-        sendButtonLEDSysEx(stepIndex, color);
+        bool isPlayhead = (localStep == currentStep);
+        return LCXL::STEP_PALETTE[(isPlayhead << 1) | seq.getStep(step)];
     }
 
-    void updateStepLEDDual(int buttonIndex, const Sequencer& seq, bool isSeqA) {
-        int localStep = isSeqA ? buttonIndex : (buttonIndex - 8);
-        int stepLength = isSeqA ? seq.stepLengthA : seq.stepLengthB;
-        int currentStep = isSeqA ? seq.currentStepA : seq.currentStepB;
-        bool showAmber = shouldShowAmber(isSeqA ? 2 : 3);  // stepLengthA or stepLengthB timer
-        bool isPlayhead = (localStep == currentStep);
-        bool isActive = seq.steps[buttonIndex];
+    // Color of a knob in the sequencer view: value knobs show length, playhead and
+    // soft takeover, parameter knobs (16-23) show soft takeover only
+    uint8_t sequencerKnobColor(int knobIndex, const Sequencer& seq) {
+        if (knobIndex >= 16) {
+            return LCXL::TAKEOVER_PALETTE[getPickupState(knobIndex)][1];
+        }
 
-        uint8_t color;
-        if (stepLength == 0 || localStep >= stepLength) {
-            color = LCXL::LED_OFF;  // Out of range or seq B disabled
-        } else if (showAmber && localStep == stepLength - 1) {
-            // Boundary marker (only while adjusting)
-            color = LCXL::LED_AMBER_FULL;
-        } else if (isPlayhead && isActive) {
-            color = LCXL::LED_GREEN_FULL;  // Playhead on active step: bright green
-        } else if (isPlayhead) {
-            color = LCXL::LED_RED_LOW;  // Playhead on inactive step: dim red
-        } else if (isActive) {
-            color = LCXL::LED_GREEN_LOW;  // Active step: dim green
-        } else {
-            color = LCXL::LED_OFF;  // Inactive step
+        int localIndex = knobIndex;
+        int valueLength = seq.valueLengthA;
+        int currentIndex = seq.currentValueIndexA;
+        int amberIndex = 0;  // valueLengthA timer
+        if (!seq.isValueSingleMode() && knobIndex >= 8) {
+            localIndex = knobIndex - 8;
+            valueLength = seq.valueLengthB;
+            currentIndex = seq.currentValueIndexB;
+            amberIndex = 1;  // valueLengthB timer
         }
-        sendButtonLEDSysEx(buttonIndex, color);
+
+        if (localIndex >= valueLength) {
+            return LCXL::LED_OFF;  // After the length
+        }
+        if (localIndex == valueLength - 1 && shouldShowAmber(amberIndex)) {
+            return LCXL::LED_AMBER_FULL;  // Last active position (only while adjusting)
+        }
+        // In range = soft takeover color (bright if playhead)
+        return LCXL::TAKEOVER_PALETTE[getPickupState(knobIndex)][localIndex == currentIndex];
     }
 
-    // Helper to get soft takeover color for a knob (bright = playhead position)
-    uint8_t getSoftTakeoverColor(int knobIndex, bool bright = false) {
-        if (lastPhysicalKnobPos[knobIndex] < 0) {
+    // Soft takeover state of a knob for the current layout
+    LCXL::PickupState getPickupState(int knobIndex) {
+        int physicalPos = lastPhysicalKnobPos[knobIndex];
+        if (physicalPos < 0) {
             // Unknown physical position - assume picked up until we receive MIDI
-            return bright ? LCXL::LED_GREEN_FULL : LCXL::LED_GREEN_LOW;
+            return LCXL::PICKUP_OK;
         }
         int storedValue = knobValues[currentLayout][knobIndex];
-        int physicalPos = lastPhysicalKnobPos[knobIndex];
-
-        if (knobPickedUp[knobIndex] || std::abs(physicalPos - storedValue) <= 2) {
-            return bright ? LCXL::LED_GREEN_FULL : LCXL::LED_GREEN_LOW;  // Picked up
+        if (knobPickedUp[currentLayout][knobIndex] || std::abs(physicalPos - storedValue) <= 2) {
+            return LCXL::PICKUP_OK;
         } else if (physicalPos < storedValue) {
-            return bright ? LCXL::LED_YELLOW_FULL : LCXL::LED_YELLOW_LOW;  // Turn right
+            return LCXL::PICKUP_TURN_RIGHT;
         } else {
-            return bright ? LCXL::LED_RED_FULL : LCXL::LED_RED_LOW;  // Turn left
+            return LCXL::PICKUP_TURN_LEFT;
         }
     }
 
@@ -793,77 +1062,36 @@ struct Core : Module {
         return (currentTime - lengthChangeTime[lengthParamIndex]) < AMBER_DISPLAY_TIME;
     }
 
-    void updateValueKnobLEDsSingle(const Sequencer& seq) {
-        // Single mode: all 16 knobs show one sequence
-        // valueLengthA = how many knobs are active (1-16)
-        bool showAmber = shouldShowAmber(0);  // valueLengthA timer
-        for (int i = 0; i < 16; i++) {
-            uint8_t color;
-            bool isPlayhead = (i == seq.currentValueIndexA);
-
-            if (i >= seq.valueLengthA) {
-                // AFTER the length = OFF
-                color = LCXL::LED_OFF;
-            } else if (showAmber && i == seq.valueLengthA - 1) {
-                // Last active position = AMBER (only while adjusting)
-                color = LCXL::LED_AMBER_FULL;
-            } else {
-                // In range = show soft takeover color (bright if playhead)
-                color = getSoftTakeoverColor(i, isPlayhead);
-            }
-            sendKnobLEDSysEx(i, color);
-        }
-    }
-
-    void updateValueKnobLEDsDual(const Sequencer& seq) {
-        bool showAmberA = shouldShowAmber(0);  // valueLengthA timer
-        bool showAmberB = shouldShowAmber(1);  // valueLengthB timer
-
-        // Row 1: Seq A values (knobs 0-7)
-        for (int i = 0; i < 8; i++) {
-            uint8_t color;
-            bool isPlayhead = (i == seq.currentValueIndexA);
-            if (i >= seq.valueLengthA) {
-                color = LCXL::LED_OFF;
-            } else if (showAmberA && i == seq.valueLengthA - 1) {
-                color = LCXL::LED_AMBER_FULL;
-            } else {
-                color = getSoftTakeoverColor(i, isPlayhead);
-            }
-            sendKnobLEDSysEx(i, color);
-        }
-
-        // Row 2: Seq B values (knobs 8-15)
-        for (int i = 0; i < 8; i++) {
-            int knobIndex = 8 + i;
-            uint8_t color;
-            bool isPlayhead = (i == seq.currentValueIndexB);
-            if (seq.valueLengthB == 0 || i >= seq.valueLengthB) {
-                color = LCXL::LED_OFF;
-            } else if (showAmberB && i == seq.valueLengthB - 1) {
-                color = LCXL::LED_AMBER_FULL;
-            } else {
-                color = getSoftTakeoverColor(knobIndex, isPlayhead);
-            }
-            sendKnobLEDSysEx(knobIndex, color);
-        }
-    }
-
+    // Fill the snapshot's write buffer and publish it
     void updateExpanderMessage() {
+        LCXLExpanderMessage& expanderMessage = snapshot->beginWrite();
         expanderMessage.moduleId = id;
         expanderMessage.currentLayout = currentLayout;
+        expanderMessage.controlRateDivision = controlRateDivision;
+        expanderMessage.morphActive = morphFader >= 0;
+        if (morphFader >= 0) {
+            std::memcpy(expanderMessage.morphKnobs, morphKnobs, sizeof(morphKnobs));
+        }
+        expanderMessage.knobRevision = knobRevision;
+        expanderMessage.morphRevision = morphKnobsRevision;
 
         // CPU optimization: use memcpy for bulk array copies
         std::memcpy(expanderMessage.faderValues, faderValues, sizeof(faderValues));
         std::memcpy(expanderMessage.knobValues, knobValues, sizeof(knobValues));
         std::memcpy(expanderMessage.buttonStates, buttonStates, sizeof(buttonStates));
         std::memcpy(expanderMessage.buttonMomentary, buttonMomentary, sizeof(buttonMomentary));
+        std::memcpy(expanderMessage.buttonPresses, buttonPresses, sizeof(buttonPresses));
+        expanderMessage.buttonRevision = buttonRevision;
 
         // Copy sequencer data
         for (int s = 0; s < 8; s++) {
             auto& dst = expanderMessage.sequencers[s];
-            auto& src = sequencers[s];
-            std::memcpy(dst.steps, src.steps, sizeof(src.steps));
+            auto& src = engine.sequencers[s];
+            // Only the shown page of steps; the playhead below is absolute
+            int page = shownPage(s);
+            dst.steps = src.getPage(page);
+            dst.page = page;
+            dst.pages = src.pages;
 
             // Sequence A data
             dst.currentStepA = src.currentStepA;
@@ -871,6 +1099,10 @@ struct Core : Module {
             dst.stepLengthA = src.stepLengthA;
             dst.valueLengthA = src.valueLengthA;
             dst.triggeredA = seqTriggeredAThisFrame[s];
+            dst.triggerOffsetA = seqTriggerOffsetA[s];
+            dst.triggerLengthA = seqTriggerLengthA[s];
+            if (seqTriggeredAThisFrame[s]) triggerCountA[s]++;
+            dst.triggerCountA = triggerCountA[s];
 
             // Sequence B data
             dst.currentStepB = src.currentStepB;
@@ -878,15 +1110,20 @@ struct Core : Module {
             dst.stepLengthB = src.stepLengthB;
             dst.valueLengthB = src.valueLengthB;
             dst.triggeredB = seqTriggeredBThisFrame[s];
+            dst.triggerOffsetB = seqTriggerOffsetB[s];
+            dst.triggerLengthB = seqTriggerLengthB[s];
+            if (seqTriggeredBThisFrame[s]) triggerCountB[s]++;
+            dst.triggerCountB = triggerCountB[s];
 
             // Mode flags
             dst.isValueSingleMode = src.isValueSingleMode();
             dst.isStepSingleMode = src.isStepSingleMode();
 
-            // Per-sequencer CV values
-            dst.cv1 = src.cv1;
-            dst.cv2 = src.cv2;
-            dst.cv3 = src.cv3;
+            // Per-sequencer CV values, with the CV modulation offset
+            int offset = (int) std::round(cvOffsets[s]);
+            dst.cv1 = clamp(src.cv1 + offset, 0, 127);
+            dst.cv2 = clamp(src.cv2 + offset, 0, 127);
+            dst.cv3 = clamp(src.cv3 + offset, 0, 127);
 
             // Voltage settings
             dst.voltageRangeA = src.voltageRangeA;
@@ -894,6 +1131,12 @@ struct Core : Module {
             dst.bipolarA = src.bipolarA;
             dst.bipolarB = src.bipolarB;
 
+            uint32_t cvs = dst.cv1 | dst.cv2 << 7 | dst.cv3 << 14 | (src.voltageRangeA & 3) << 21 | src.bipolarA << 23;
+            if (cvs != publishedCVs[s]) {
+                publishedCVs[s] = cvs;
+                cvRevision++;
+            }
+
             // Slewed CV outputs
             dst.slewedCVA = src.currentSlewA;
             dst.slewedCVB = src.currentSlewB;
@@ -907,9 +1150,12 @@ struct Core : Module {
             dst.valueEnd = src.valueLengthA - 1;
             dst.triggered = seqTriggeredAThisFrame[s];
         }
+        expanderMessage.cvRevision = cvRevision;
 
         // Copy last change info
         expanderMessage.lastChange = lastChange;
+
+        snapshot->publish();
     }
 
     void initializeDevice() {
@@ -918,13 +1164,45 @@ struct Core : Module {
             return;
         }
 
-        // First, force the Launch Control XL to template 8 (Factory Template 1)
-        sendForceTemplate(8);
-        // Then reset/clean all LEDs
-        sendResetLEDs();
+        // Force the Launch Control XL to our template, then repaint all of it: the
+        // controller may have been power cycled or changed by other software
+        sendForceTemplate(deviceTemplate);
         takenOver = true;
-        // Update LEDs with our state
-        updateAllLEDs();
+        beginResync(true);
+    }
+
+    // Repaint our template from lastLEDState over the next control-rate ticks.
+    // Unlike a reset (Bn 00 00) the LEDs never go dark in between. Unless the
+    // mirror is forgotten first, LEDs it knows the hardware shows already are
+    // skipped by LCXLDevice::flush, so only what changed is sent.
+    void beginResync(bool forgetShown) {
+        if (!device) return;
+        if (forgetShown) device->forget(deviceTemplate);
+        ledQueue.clear();  // Everything is queued again below
+        updateAllLEDs();  // Make sure lastLEDState holds every color we want shown
+        resyncPosition = 0;
+    }
+
+    void stepResync() {
+        int end = std::min(resyncPosition + RESYNC_BATCH, LCXLDevice::NUM_LEDS);
+        for (int i = resyncPosition; i < end; i++) {
+            // Side button LEDs (40-47) aren't used by Core and are turned off
+            uint8_t color = (i < 40 && lastLEDState[i] != 0xFF) ? lastLEDState[i] : LCXL::LED_OFF;
+            ledQueue.queue(i, color);
+        }
+        resyncPosition = end;
+    }
+
+    // Template change reported by the controller (its template buttons were pressed)
+    void onTemplateSelected(int tmpl) {
+        if (!device) return;
+        device->selectedTemplate = tmpl;
+        if (tmpl == deviceTemplate && !takenOver) {
+            // Back on our template: the controller kept its LEDs, so the mirror
+            // still holds and only what changed while it was away is sent
+            takenOver = true;
+            beginResync(false);
+        }
     }
 
     void performTakeover() {
@@ -943,31 +1221,68 @@ struct Core : Module {
             0xF7
         };
         midiOutput.sendMessage(msg);
+        if (device) {
+            device->selectedTemplate = templateNum;
+        }
+    }
+
+    void setControlRateDivision(int division) {
+        controlRateDivision = clamp(division, 1, 256);
+        controlDivider.setDivision(controlRateDivision);
+    }
+
+    // Select the device template, and with it the MIDI channel this Core listens to
+    void setDeviceTemplate(int newTemplate) {
+        if (newTemplate == deviceTemplate) return;
+        deviceTemplate = newTemplate;
+        midiInput.channel = newTemplate;
+        // Called from the UI thread: let process() re-initialize the controller on
+        // the new template as if the output had just been connected
+        lastMidiOutputDeviceId = -1;
     }
 
     void processMidiMessage(const midi::Message& msg) {
-        int channel = msg.getChannel();
+        // Channel filtering (our template only) is done by midiInput
         int status = msg.getStatus();
 
-        // Only process messages on our expected channel
-        if (channel != LCXL::MIDI_CHANNEL) {
-            return;
-        }
-
         switch (status) {
             case 0xb: // Control Change
                 processCCMessage(msg.getNote(), msg.getValue());
                 break;
             case 0x9: // Note On
+                journal.seal();  // Pressing a button ends a knob turn
                 processNoteOn(msg.getNote(), msg.getValue());
                 break;
             case 0x8: // Note Off
                 processNoteOff(msg.getNote());
                 break;
+            case 0xf: { // SysEx (not channel filtered): template change F0 00 20 29 02 11 77 [template] F7
+                const std::vector<uint8_t>& b = msg.bytes;
+                if (b.size() >= 9 && b[0] == 0xF0 && std::equal(LCXL::SYSEX_HEADER, LCXL::SYSEX_HEADER + 5, b.begin() + 1)
+                    && b[6] == 0x77) {
+                    onTemplateSelected(b[7] & 0x0F);
+                }
+                break;
+            }
         }
     }
 
     void processCCMessage(int cc, int value) {
+        // Device + Left/Right: undo/redo
+        if (deviceButtonHeld && (cc == LCXL::BTN_LEFT || cc == LCXL::BTN_RIGHT)) {
+            if (value > 0) {
+                if (cc == LCXL::BTN_LEFT) undoEdit();
+                else redoEdit();
+            }
+            return;
+        }
+
+        // Sequencer layouts: Up/Down/Left/Right page through long patterns
+        if (currentLayout > 0 && cc >= LCXL::BTN_UP && cc <= LCXL::BTN_RIGHT) {
+            if (value > 0) processPageButton(cc);
+            return;
+        }
+
         // Check faders
         for (int i = 0; i < 8; i++) {
             if (cc == LCXL::FADERS[i]) {
@@ -1004,6 +1319,20 @@ struct Core : Module {
     void processKnobChange(int knobIndex, int value) {
         // In sequencer mode, bottom row knobs (16-23) are parameters - bypass soft takeover
         bool isParameterKnob = (currentLayout > 0 && knobIndex >= 16);
+        int previousValue = knobValues[currentLayout][knobIndex];
+
+        // Device + Solo in sequencer mode: knob 1 selects the preset group, knob 2 the preset
+        if (deviceButtonHeld && soloHeld && currentLayout > 0 && knobIndex < 2) {
+            lastPhysicalKnobPos[knobIndex] = value;
+            browsePreset();
+            return;
+        }
+
+        // Device in sequencer mode: knobs 1-3 and 9-10 are step generators
+        if (deviceButtonHeld && currentLayout > 0 && (knobIndex % 8 < 2 ? knobIndex < 16 : knobIndex == 2)) {
+            processGeneratorKnob(knobIndex, value);
+            return;
+        }
 
         // If RecArm is held in sequencer mode and this is a value knob, control glide time
         if (recArmHeld && currentLayout > 0 && knobIndex < 16) {
@@ -1014,42 +1343,116 @@ struct Core : Module {
         if (isParameterKnob) {
             // Parameter knobs work immediately without soft takeover
             knobValues[currentLayout][knobIndex] = value;
-            knobPickedUp[knobIndex] = true;
+            knobPickedUp[currentLayout][knobIndex] = true;
             int paramIdx = knobIndex - 16;
             processSequencerParameter(paramIdx, value);
         } else {
             // Soft takeover logic for value knobs
             int storedValue = knobValues[currentLayout][knobIndex];
 
-            if (!knobPickedUp[knobIndex]) {
+            bool* pickedUp = &knobPickedUp[currentLayout][knobIndex];
+            if (!*pickedUp) {
                 // Check if we've reached the pickup zone (±2)
                 if (std::abs(value - storedValue) <= 2) {
-                    knobPickedUp[knobIndex] = true;
+                    *pickedUp = true;
                 }
             }
 
-            if (knobPickedUp[knobIndex]) {
+            if (*pickedUp) {
                 knobValues[currentLayout][knobIndex] = value;
             }
         }
 
         lastPhysicalKnobPos[knobIndex] = value;
+        knobRevision++;
+        journalEdit(EDIT_KNOB, currentLayout, knobIndex, previousValue, knobValues[currentLayout][knobIndex], true);
 
         // Update LED - in sequencer mode, value knobs show sequencer state with soft takeover
         if (currentLayout > 0 && knobIndex < 16) {
-            Sequencer& seq = sequencers[currentLayout - 1];
-            if (seq.isValueSingleMode()) {
-                updateValueKnobLEDsSingle(seq);
-            } else {
-                updateValueKnobLEDsDual(seq);
-            }
+            markLED(knobIndex);
+            renderSequencerLEDs();
         } else {
             updateKnobLED(knobIndex);
         }
     }
 
+    // Device + knob 1/9: Euclidean fill of A/B, knob 2/10: rotate A/B, knob 3: density
+    void processGeneratorKnob(int knobIndex, int value) {
+        int seqIdx = currentLayout - 1;
+        Sequencer& seq = engine.sequencers[seqIdx];
+        int which = knobIndex / 8;  // Top row A, middle row B
+        int length = which == 0 ? seq.stepLengthA : (seq.isStepSingleMode() ? 0 : seq.stepLengthB);
+        int lastValue = lastPhysicalKnobPos[knobIndex];
+        lastPhysicalKnobPos[knobIndex] = value;
+
+        if (knobIndex == 2) {
+            journalEdit(EDIT_DENSITY, currentLayout, 0, (int) std::round(seq.density * 127.f), value, true);
+            seq.density = value / 127.f;
+            recordChange(CHANGE_DENSITY, currentLayout, value * 100 / 127);
+            return;
+        }
+        if (length <= 0) return;
+
+        if (!generatorEdit) {
+            generatorBefore = seq;
+            generatorLayout = currentLayout;
+            generatorEdit = true;
+        }
+        if (knobIndex % 8 == 0) {
+            // Hits 0 to length over the knob's travel
+            int hits = value * (length + 1) / 128;
+            engine.euclideanFill(seqIdx, which, hits);
+            recordChange(CHANGE_EUCLID, currentLayout, hits, length);
+        } else {
+            // Rotate one step per 1/length of the knob's travel, in the direction it turns
+            if (lastValue < 0) return;
+            int amount = value * length / 128 - lastValue * length / 128;
+            if (amount == 0) return;
+            engine.rotateSequence(seqIdx, which, amount);
+            recordChange(CHANGE_ROTATE, currentLayout, amount);
+        }
+        updateSequencerLEDs();
+    }
+
+    // Recall the preset under knobs 1-2 into the current sequencer
+    void browsePreset() {
+        int group = std::max(lastPhysicalKnobPos[0], 0) * 16 / 128;
+        int position = std::max(lastPhysicalKnobPos[1], 0) * 16 / 128;
+        int index = group * 16 + position;
+        if (index == selectedPreset) return;
+        selectedPreset = index;
+
+        PresetRecord record;
+        bool empty = true;
+        if (presetLibrary.isOpen()) {
+            // A record being stored from the menu is recalled on the next knob change
+            if (!presetLibrary.read(index, &record)) {
+                selectedPreset = -1;
+                return;
+            }
+            empty = !record.used;
+        }
+        if (!empty) {
+            int seqIdx = currentLayout - 1;
+            engine.loadPreset(seqIdx, &record, knobValues[currentLayout]);
+            onPatternLoaded(seqIdx);
+        }
+        recordChange(CHANGE_PRESET, currentLayout, index + 1, empty ? 1 : 0);
+    }
+
+    // Store a sequencer in a preset record (from the menu, through a staging record)
+    void storePreset(int seqIdx, int index) {
+        PresetRecord record;
+        engine.storePreset(seqIdx, knobValues[seqIdx + 1], &record);
+        presetLibrary.write(index, record);
+    }
+
+    void clearPreset(int index) {
+        presetLibrary.write(index, PresetRecord());  // used = 0
+    }
+
     void processGlideKnobChange(int knobIndex, int value) {
-        Sequencer& seq = sequencers[currentLayout - 1];
+        Sequencer& seq = engine.sequencers[currentLayout - 1];
         int seqIdx = currentLayout - 1;
 
         // Soft takeover logic for glide time
@@ -1063,6 +1466,7 @@ struct Core : Module {
         }
 
         if (glidePickedUp[seqIdx][knobIndex]) {
+            journalEdit(EDIT_GLIDE, currentLayout, knobIndex, seq.glideTime[knobIndex], value, true);
             seq.glideTime[knobIndex] = value;
         }
 
@@ -1074,51 +1478,44 @@ struct Core : Module {
 
     void processSequencerParameter(int paramIndex, int value) {
         // paramIndex: 0=VAL-A, 1=VAL-B, 2=STEP-A, 3=STEP-B, 4=BIAS, 5=CV1, 6=CV2, 7=CV3
-        Sequencer& seq = sequencers[currentLayout - 1];
+        int seqIdx = currentLayout - 1;
+        Sequencer& seq = engine.sequencers[seqIdx];
 
         switch (paramIndex) {
             case 0:  // Value Length A (1-16)
-                seq.valueLengthA = 1 + (value * 15 / 127);  // Map 0-127 to 1-16
-                if (seq.currentValueIndexA >= seq.valueLengthA) {
-                    seq.currentValueIndexA = 0;
-                }
+                engine.setValueLengthA(seqIdx, value);
                 lengthChangeTime[0] = currentTime;  // Record time for amber display
                 recordChange(CHANGE_VALUE_LENGTH_A, currentLayout, seq.valueLengthA);
-                updateSequencerLEDs();
+                markLengthLEDs(0, seq);
+                renderSequencerLEDs();
                 break;
 
             case 1:  // Value Length B (0-8)
-                seq.valueLengthB = value * 9 / 128;  // Map 0-127 to 0-8
-                if (seq.valueLengthB > 0 && seq.currentValueIndexB >= seq.valueLengthB) {
-                    seq.currentValueIndexB = 0;
-                }
+                engine.setValueLengthB(seqIdx, value);
                 lengthChangeTime[1] = currentTime;  // Record time for amber display
                 recordChange(CHANGE_VALUE_LENGTH_B, currentLayout, seq.valueLengthB);
-                updateSequencerLEDs();
+                markLengthLEDs(1, seq);
+                renderSequencerLEDs();
                 break;
 
             case 2:  // Step Length A (1-16)
-                seq.stepLengthA = 1 + (value * 15 / 127);  // Map 0-127 to 1-16
-                if (seq.currentStepA >= seq.stepLengthA) {
-                    seq.currentStepA = 0;
-                }
+                engine.setStepLengthA(seqIdx, value);
                 lengthChangeTime[2] = currentTime;  // Record time for amber display
                 recordChange(CHANGE_STEP_LENGTH_A, currentLayout, seq.stepLengthA);
-                updateSequencerLEDs();
+                markLengthLEDs(2, seq);
+                renderSequencerLEDs();
                 break;
 
             case 3:  // Step Length B (0-8)
-                seq.stepLengthB = value * 9 / 128;  // Map 0-127 to 0-8
-                if (seq.stepLengthB > 0 && seq.currentStepB >= seq.stepLengthB) {
-                    seq.currentStepB = 0;
-                }
+                engine.setStepLengthB(seqIdx, value);
                 lengthChangeTime[3] = currentTime;  // Record time for amber display
                 recordChange(CHANGE_STEP_LENGTH_B, currentLayout, seq.stepLengthB);
-                updateSequencerLEDs();
+                markLengthLEDs(3, seq);
+                renderSequencerLEDs();
                 break;
 
             case 4:  // Bias/Amount (0-100%)
-                seq.bias = value / 127.f;
+                engine.setBias(seqIdx, value);
                 recordChange(CHANGE_BIAS, currentLayout, value * 100 / 127);
                 break;
 
@@ -1162,6 +1559,59 @@ struct Core : Module {
             return;
         }
 
+        // Mute button: hold for the pattern bank (sequencer layouts)
+        if (note == LCXL::BTN_MUTE) {
+            muteHeld = true;
+            if (currentLayout > 0) {
+                showPatternBankLEDs();
+            }
+            return;
+        }
+
+        // Solo button: hold for trig conditions (sequencer layouts).
+        // With Mute held, step buttons store instead of switch.
+        if (note == LCXL::BTN_SOLO) {
+            soloHeld = true;
+            if (currentLayout > 0 && !muteHeld && !deviceButtonHeld) {
+                showConditionLEDs();
+            }
+            return;
+        }
+
+        // If Mute is held in sequencer mode, step buttons select pattern 1-16
+        if (muteHeld && currentLayout > 0) {
+            int slot = getStepIndexFromNote(note);
+            if (slot >= 0) {
+                int seqIdx = currentLayout - 1;
+                if (soloHeld) {
+                    // Store the live pattern in the slot (without switching)
+                    engine.storePattern(seqIdx, slot, knobValues[currentLayout]);
+                } else {
+                    // Switch at the next loop boundary
+                    engine.queuePattern(seqIdx, slot);
+                    recordChange(CHANGE_PATTERN, currentLayout, slot + 1, 1);
+                }
+                showPatternBankLEDs();
+            }
+            return;
+        }
+
+        // If Solo is held in sequencer mode, step buttons cycle their trig condition
+        if (soloHeld && currentLayout > 0 && !deviceButtonHeld) {
+            int stepIndex = getStepIndexFromNote(note);
+            if (stepIndex >= 0) {
+                int seqIdx = currentLayout - 1;
+                int step = stepIndex + 16 * shownPage(seqIdx);
+                int condition = engine.sequencers[seqIdx].getCondition(step);
+                int next = (condition + 1) % NUM_CONDITIONS;
+                journalEdit(EDIT_CONDITION, currentLayout, step, condition, next);
+                engine.setStepCondition(seqIdx, step, next);
+                recordChange(CHANGE_STEP_CONDITION, currentLayout, next, step);
+                showConditionLEDs();
+            }
+            return;
+        }
+
         // If Record Arm is held in default layout, toggle button momentary mode
         if (recArmHeld && currentLayout == 0) {
             // Track Focus buttons = buttons 0-7
@@ -1170,7 +1620,7 @@ struct Core : Module {
                     buttonMomentary[i] = !buttonMomentary[i];
                     // If switching to momentary, turn off the gate
                     if (buttonMomentary[i]) {
-                        buttonStates[i] = false;
+                        setButtonState(i, false);
                     }
                     updateButtonLED(i, buttonStates[i]);
                     return;
@@ -1182,7 +1632,7 @@ struct Core : Module {
                     buttonMomentary[8 + i] = !buttonMomentary[8 + i];
                     // If switching to momentary, turn off the gate
                     if (buttonMomentary[8 + i]) {
-                        buttonStates[8 + i] = false;
+                        setButtonState(8 + i, false);
                     }
                     updateButtonLED(8 + i, buttonStates[8 + i]);
                     return;
@@ -1192,16 +1642,18 @@ struct Core : Module {
 
         // If Record Arm is held in sequencer mode, handle mode selection and voltage/bipolar settings
         if (recArmHeld && currentLayout > 0) {
-            Sequencer& seq = sequencers[currentLayout - 1];
+            Sequencer& seq = engine.sequencers[currentLayout - 1];
 
             // Track Focus row (top): Mode selection (all 8 buttons for competition/routing modes)
             for (int m = 0; m < 8; m++) {
                 if (note == LCXL::TRACK_FOCUS[m]) {
                     if (seq.isStepSingleMode()) {
-                        seq.routingMode = m;
+                        journalEdit(EDIT_ROUTE_MODE, currentLayout, 0, seq.routingMode, m);
+                        engine.setRoutingMode(currentLayout - 1, m);
                         recordChange(CHANGE_ROUTE_MODE, currentLayout, m);
                     } else {
-                        seq.competitionMode = m;
+                        journalEdit(EDIT_COMP_MODE, currentLayout, 0, seq.competitionMode, m);
+                        engine.setCompetitionMode(currentLayout - 1, m);
                         recordChange(CHANGE_COMP_MODE, currentLayout, m);
                     }
                     showModeSelectionLEDs();
@@ -1212,6 +1664,7 @@ struct Core : Module {
             // Track Control row (bottom): Voltage and polarity settings
             // Button 1: Cycle voltage range A (green=5V, amber=10V, red=1V)
             if (note == LCXL::TRACK_CONTROL[0]) {
+                journalEdit(EDIT_VOLTAGE_A, currentLayout, 0, seq.voltageRangeA, (seq.voltageRangeA + 1) % 3);
                 seq.voltageRangeA = (seq.voltageRangeA + 1) % 3;
                 recordChange(CHANGE_VOLTAGE_A, currentLayout, seq.voltageRangeA);
                 showModeSelectionLEDs();
@@ -1219,6 +1672,7 @@ struct Core : Module {
             }
             // Button 2: Toggle bipolar A
             if (note == LCXL::TRACK_CONTROL[1]) {
+                journalEdit(EDIT_BIPOLAR_A, currentLayout, 0, seq.bipolarA, !seq.bipolarA);
                 seq.bipolarA = !seq.bipolarA;
                 recordChange(CHANGE_BIPOLAR_A, currentLayout, seq.bipolarA ? 1 : 0);
                 showModeSelectionLEDs();
@@ -1226,6 +1680,7 @@ struct Core : Module {
             }
             // Button 5: Cycle voltage range B
             if (note == LCXL::TRACK_CONTROL[4]) {
+                journalEdit(EDIT_VOLTAGE_B, currentLayout, 0, seq.voltageRangeB, (seq.voltageRangeB + 1) % 3);
                 seq.voltageRangeB = (seq.voltageRangeB + 1) % 3;
                 recordChange(CHANGE_VOLTAGE_B, currentLayout, seq.voltageRangeB);
                 showModeSelectionLEDs();
@@ -1233,11 +1688,20 @@ struct Core : Module {
             }
             // Button 6: Toggle bipolar B
             if (note == LCXL::TRACK_CONTROL[5]) {
+                journalEdit(EDIT_BIPOLAR_B, currentLayout, 0, seq.bipolarB, !seq.bipolarB);
                 seq.bipolarB = !seq.bipolarB;
                 recordChange(CHANGE_BIPOLAR_B, currentLayout, seq.bipolarB ? 1 : 0);
                 showModeSelectionLEDs();
                 return;
             }
+            // Button 8: Toggle fill (COND_FILL / COND_NOT_FILL steps)
+            if (note == LCXL::TRACK_CONTROL[7]) {
+                journalEdit(EDIT_FILL, currentLayout, 0, seq.fill, !seq.fill);
+                engine.setFill(currentLayout - 1, !seq.fill);
+                recordChange(CHANGE_FILL, currentLayout, seq.fill ? 1 : 0);
+                showModeSelectionLEDs();
+                return;
+            }
         }
 
         // If Device is held, check for layout switching and utilities
@@ -1279,7 +1743,7 @@ struct Core : Module {
 
     void showGlideLEDs() {
         if (currentLayout <= 0) return;
-        Sequencer& seq = sequencers[currentLayout - 1];
+        Sequencer& seq = engine.sequencers[currentLayout - 1];
         int seqIdx = currentLayout - 1;
 
         // Show glide status for value knobs (0-15)
@@ -1315,7 +1779,7 @@ struct Core : Module {
 
     void showModeSelectionLEDs() {
         if (currentLayout <= 0) return;
-        Sequencer& seq = sequencers[currentLayout - 1];
+        Sequencer& seq = engine.sequencers[currentLayout - 1];
 
         // Also show glide LEDs on value knobs
         showGlideLEDs();
@@ -1348,9 +1812,11 @@ struct Core : Module {
         // Button 13 (index 5): Bipolar B
         sendButtonLEDSysEx(13, seq.bipolarB ? LCXL::LED_RED_FULL : LCXL::LED_GREEN_FULL);
 
-        // Buttons 14, 15: Off
+        // Button 14: Off
         sendButtonLEDSysEx(14, LCXL::LED_OFF);
-        sendButtonLEDSysEx(15, LCXL::LED_OFF);
+
+        // Button 15 (index 7): Fill (red = on)
+        sendButtonLEDSysEx(15, seq.fill ? LCXL::LED_RED_FULL : LCXL::LED_OFF);
     }
 
     void showLayoutSelectionLEDs() {
@@ -1371,102 +1837,218 @@ struct Core : Module {
         }
     }
 
+    // Trig conditions of the shown page on the step buttons (off = always)
+    void showConditionLEDs() {
+        int s = currentLayout - 1;
+        const Sequencer& seq = engine.sequencers[s];
+        int first = 16 * shownPage(s);
+        for (int i = 0; i < 16; i++) {
+            sendButtonLEDSysEx(i, LCXL::CONDITION_PALETTE[seq.getCondition(first + i)]);
+        }
+    }
+
+    // Pattern bank on the step buttons: green = playing, amber = queued
+    void showPatternBankLEDs() {
+        const PatternBank& bank = engine.banks[currentLayout - 1];
+        for (int i = 0; i < PatternBank::SIZE; i++) {
+            uint8_t color = LCXL::LED_OFF;
+            if (i == bank.queued) {
+                color = LCXL::LED_AMBER_FULL;
+            } else if (i == bank.active) {
+                color = LCXL::LED_GREEN_FULL;
+            }
+            sendButtonLEDSysEx(i, color);
+        }
+    }
+
     void executeSequencerUtility(int utilityIndex) {
-        Sequencer& seq = sequencers[currentLayout - 1];
+        int seqIdx = currentLayout - 1;
+
+        // Step and value utilities are journaled as one edit of the changed steps/knobs
+        const Sequencer before = engine.sequencers[seqIdx];
+        int valuesBefore[16];
+        std::copy(knobValues[currentLayout], knobValues[currentLayout] + 16, valuesBefore);
 
         switch (utilityIndex) {
             case 1:  // Copy current sequencer
-                copyBuffer = seq;
+                engine.copySequencer(seqIdx);
                 break;
 
             case 2:  // Paste to current sequencer
-                seq.steps[0] = copyBuffer.steps[0];  // Copy step pattern
-                for (int i = 0; i < 16; i++) {
-                    seq.steps[i] = copyBuffer.steps[i];
-                }
+                engine.pasteSteps(seqIdx);
                 updateSequencerLEDs();
                 break;
 
             case 3:  // Clear all steps
-                for (int i = 0; i < 16; i++) {
-                    seq.steps[i] = false;
-                }
+                engine.clearSteps(seqIdx);
                 updateSequencerLEDs();
                 break;
 
             case 4:  // Randomize steps
-                for (int i = 0; i < 16; i++) {
-                    seq.steps[i] = random::uniform() > 0.5f;
-                }
+                engine.randomizeSteps(seqIdx);
                 updateSequencerLEDs();
                 break;
 
             case 5:  // Randomize values
-                for (int i = 0; i < 16; i++) {
-                    knobValues[currentLayout][i] = static_cast<int>(random::uniform() * 127);
-                }
+                engine.randomizeValues(knobValues[currentLayout]);
+                knobRevision++;
                 updateSequencerLEDs();
                 break;
 
             case 6:  // Invert steps
-                for (int i = 0; i < 16; i++) {
-                    seq.steps[i] = !seq.steps[i];
-                }
+                engine.invertSteps(seqIdx);
                 updateSequencerLEDs();
                 break;
 
             case 7:  // Reset playheads
-                seq.currentStepA = 0;
-                seq.currentStepB = 0;
-                seq.currentValueIndexA = 0;
-                seq.currentValueIndexB = 0;
-                seq.alternateCounter = 0;
+                engine.resetPlayheads(seqIdx);
                 updateSequencerLEDs();
                 break;
         }
+
+        bool chained = journalStepEdits(currentLayout, before, false);
+        for (int i = 0; i < 16; i++) {
+            if (knobValues[currentLayout][i] != valuesBefore[i]) {
+                journalEdit(EDIT_KNOB, currentLayout, i, valuesBefore[i], knobValues[currentLayout][i], false, chained);
+                chained = true;
+            }
+        }
+    }
+
+    // Journal the steps and trig conditions of a layout's sequencer that differ from
+    // `before`. Returns whether anything was journaled (the next record chains on).
+    bool journalStepEdits(int layout, const Sequencer& before, bool chained) {
+        const Sequencer& after = engine.sequencers[layout - 1];
+        uint64_t changedSteps = after.steps ^ before.steps;
+        uint64_t changedConditions = 0;
+        for (int c = 0; c < NUM_CONDITIONS - 1; c++) {
+            changedConditions |= after.conditionSteps[c] ^ before.conditionSteps[c];
+        }
+        for (int i = 0; i < Sequencer::MAX_STEPS; i++) {
+            if ((changedSteps >> i) & 1) {
+                journalEdit(EDIT_STEP, layout, i, before.getStep(i), after.getStep(i), false, chained);
+                chained = true;
+            }
+            if ((changedConditions >> i) & 1) {
+                journalEdit(EDIT_CONDITION, layout, i, before.getCondition(i), after.getCondition(i), false, chained);
+                chained = true;
+            }
+        }
+        return chained;
     }
 
-    // Copy buffer for sequencer copy/paste
-    Sequencer copyBuffer;
+    // Add an edit to the undo journal (no-op if nothing changed).
+    // merge: continuous controls (knobs) coalesce into one edit per turn.
+    // chained: undone together with the previous edit.
+    void journalEdit(EditField field, int layout, int index, int oldValue, int newValue, bool merge = false, bool chained = false) {
+        if (oldValue == newValue) return;
+        EditRecord record;
+        record.field = field;
+        record.layout = layout;
+        record.index = index;
+        record.chained = chained ? 1 : 0;
+        record.oldValue = oldValue;
+        record.newValue = newValue;
+        if (currentTime - lastJournalTime > JOURNAL_MERGE_TIME) journal.seal();
+        lastJournalTime = currentTime;
+        journal.push(record, merge);
+    }
 
-    // Convert knob value (0-127) to voltage based on range and bipolar settings
-    // Range: 0=5V, 1=10V, 2=1V
-    // Bipolar: false=unipolar (0 to max), true=bipolar (-max/2 to +max/2)
-    float knobToVoltage(int knobValue, int voltageRange, bool bipolar) {
-        float normalized = knobValue / 127.f;  // 0.0 to 1.0
-        float maxVoltage;
-        switch (voltageRange) {
-            case 0: maxVoltage = 5.f; break;   // Green: 5V
-            case 1: maxVoltage = 10.f; break;  // Amber: 10V
-            case 2: maxVoltage = 1.f; break;   // Red: 1V
-            default: maxVoltage = 5.f; break;
+    // Set a journaled field to its old (undo) or new (redo) value
+    void applyEdit(const EditRecord& edit, bool undo) {
+        int value = undo ? edit.oldValue : edit.newValue;
+        int layout = edit.layout;
+        int i = edit.index;
+        Sequencer& seq = engine.sequencers[std::max(layout - 1, 0)];
+
+        switch (edit.field) {
+            case EDIT_KNOB:
+                knobValues[layout][i] = value;
+                knobRevision++;
+                if (layout > 0 && i >= 16) {
+                    applySequencerParameter(layout - 1, i - 16, value);
+                } else {
+                    // The physical knob stays where it is; pick the restored value up again
+                    knobPickedUp[layout][i] = lastPhysicalKnobPos[i] >= 0 && std::abs(lastPhysicalKnobPos[i] - value) <= 2;
+                }
+                break;
+            case EDIT_GLIDE:
+                seq.glideTime[i] = value;
+                glidePickedUp[layout - 1][i] = lastPhysicalGlidePos[layout - 1][i] >= 0 && std::abs(lastPhysicalGlidePos[layout - 1][i] - value) <= 2;
+                break;
+            case EDIT_STEP: seq.setStep(i, value != 0); break;
+            case EDIT_CONDITION: engine.setStepCondition(layout - 1, i, value); break;
+            case EDIT_PAGES: engine.setPages(layout - 1, value); break;
+            case EDIT_FILL: engine.setFill(layout - 1, value != 0); break;
+            case EDIT_DENSITY: seq.density = value / 127.f; break;
+            case EDIT_COMP_MODE: engine.setCompetitionMode(layout - 1, value); break;
+            case EDIT_ROUTE_MODE: engine.setRoutingMode(layout - 1, value); break;
+            case EDIT_VOLTAGE_A: seq.voltageRangeA = value; break;
+            case EDIT_VOLTAGE_B: seq.voltageRangeB = value; break;
+            case EDIT_BIPOLAR_A: seq.bipolarA = value != 0; break;
+            case EDIT_BIPOLAR_B: seq.bipolarB = value != 0; break;
         }
-        if (bipolar) {
-            return normalized * maxVoltage - (maxVoltage / 2.f);  // -max/2 to +max/2
-        } else {
-            return normalized * maxVoltage;  // 0 to max
+    }
+
+    // Set a sequencer parameter from its knob value without display/LED side effects
+    void applySequencerParameter(int seqIdx, int paramIndex, int value) {
+        Sequencer& seq = engine.sequencers[seqIdx];
+        switch (paramIndex) {
+            case 0: engine.setValueLengthA(seqIdx, value); break;
+            case 1: engine.setValueLengthB(seqIdx, value); break;
+            case 2: engine.setStepLengthA(seqIdx, value); break;
+            case 3: engine.setStepLengthB(seqIdx, value); break;
+            case 4: engine.setBias(seqIdx, value); break;
+            case 5: seq.cv1 = value; break;
+            case 6: seq.cv2 = value; break;
+            case 7: seq.cv3 = value; break;
         }
     }
 
-    // Apply exponential slew (RC filter style)
-    // current: current output value
-    // target: target value to slew toward
-    // glideTime: time constant in seconds (0 = instant)
-    // sampleTime: time for this sample
-    float applySlewExp(float current, float target, float glideTime, float sampleTime) {
-        if (glideTime <= 0.f || glideTime < sampleTime) {
-            return target;  // No glide or glide time too short
+    void undoEdit() {
+        if (journal.undo([this](const EditRecord& edit, bool undo) { applyEdit(edit, undo); }) == 0) return;
+        onEditRestored(false);
+    }
+
+    void redoEdit() {
+        if (journal.redo([this](const EditRecord& edit, bool undo) { applyEdit(edit, undo); }) == 0) return;
+        onEditRestored(true);
+    }
+
+    void onEditRestored(bool redo) {
+        recordChange(CHANGE_UNDO, currentLayout, redo ? journal.redoCount : journal.undoCount, redo ? 1 : 0);
+        // A held overlay redraws everything when it is released
+        if (!isOverlayShown()) {
+            updateAllLEDs();
         }
-        // Exponential slew: move a percentage toward target each sample
-        // lambda = 1 - e^(-sampleTime / glideTime) for accurate RC filter
-        // Simplified: lambda = sampleTime / glideTime (good approximation for small values)
-        float lambda = std::min(1.f, sampleTime / glideTime * 4.f);  // *4 to reach target faster
-        return current + (target - current) * lambda;
     }
 
     void processNoteOff(int note) {
+        if (note == LCXL::BTN_MUTE) {
+            muteHeld = false;
+            // Restore normal LEDs when releasing Mute
+            if (currentLayout > 0) {
+                updateSequencerLEDs();
+            }
+            return;
+        }
+
+        if (note == LCXL::BTN_SOLO) {
+            soloHeld = false;
+            // Restore normal LEDs when releasing Solo
+            if (currentLayout > 0 && !isOverlayShown()) {
+                updateSequencerLEDs();
+            }
+            return;
+        }
+
         if (note == LCXL::BTN_DEVICE) {
             deviceButtonHeld = false;
+            selectedPreset = -1;  // Browsing again recalls the preset under the knobs
+            if (generatorEdit) {
+                generatorEdit = false;
+                journalStepEdits(generatorLayout, generatorBefore, false);
+            }
             // Restore normal LEDs when releasing Device
             updateAllLEDs();
             return;
@@ -1491,7 +2073,7 @@ struct Core : Module {
             // Track Focus buttons = buttons 0-7
             for (int i = 0; i < 8; i++) {
                 if (note == LCXL::TRACK_FOCUS[i] && buttonMomentary[i]) {
-                    buttonStates[i] = false;
+                    setButtonState(i, false);
                     updateButtonLED(i, buttonStates[i]);
                     return;
                 }
@@ -1499,7 +2081,7 @@ struct Core : Module {
             // Track Control buttons = buttons 8-15
             for (int i = 0; i < 8; i++) {
                 if (note == LCXL::TRACK_CONTROL[i] && buttonMomentary[8 + i]) {
-                    buttonStates[8 + i] = false;
+                    setButtonState(8 + i, false);
                     updateButtonLED(8 + i, buttonStates[8 + i]);
                     return;
                 }
@@ -1507,16 +2089,24 @@ struct Core : Module {
         }
     }
 
+    // Set a default layout button's gate (the caller updates its LED)
+    void setButtonState(int i, bool on) {
+        if (buttonStates[i] == on) return;
+        buttonStates[i] = on;
+        buttonRevision++;
+    }
+
     void processDefaultModeButton(int note) {
         // Track Focus buttons = gates 1-8
         for (int i = 0; i < 8; i++) {
             if (note == LCXL::TRACK_FOCUS[i]) {
+                buttonPresses[i]++;
                 if (buttonMomentary[i]) {
                     // Momentary mode: turn on when pressed
-                    buttonStates[i] = true;
+                    setButtonState(i, true);
                 } else {
                     // Toggle mode: toggle on/off
-                    buttonStates[i] = !buttonStates[i];
+                    setButtonState(i, !buttonStates[i]);
                 }
                 updateButtonLED(i, buttonStates[i]);
                 return;
@@ -1526,12 +2116,13 @@ struct Core : Module {
         // Track Control buttons = gates 9-16
         for (int i = 0; i < 8; i++) {
             if (note == LCXL::TRACK_CONTROL[i]) {
+                buttonPresses[8 + i]++;
                 if (buttonMomentary[8 + i]) {
                     // Momentary mode: turn on when pressed
-                    buttonStates[8 + i] = true;
+                    setButtonState(8 + i, true);
                 } else {
                     // Toggle mode: toggle on/off
-                    buttonStates[8 + i] = !buttonStates[8 + i];
+                    setButtonState(8 + i, !buttonStates[8 + i]);
                 }
                 updateButtonLED(8 + i, buttonStates[8 + i]);
                 return;
@@ -1553,19 +2144,55 @@ struct Core : Module {
         if (stepIndex < 0) return;
 
         int seqIndex = currentLayout - 1;
-        Sequencer& seq = sequencers[seqIndex];
+        Sequencer& seq = engine.sequencers[seqIndex];
 
-        // Toggle step on/off
-        seq.steps[stepIndex] = !seq.steps[stepIndex];
-        recordChange(CHANGE_STEP_TOGGLE, currentLayout, seq.steps[stepIndex] ? 1 : 0, stepIndex);
+        // Toggle step on/off (on the shown page)
+        int step = stepIndex + 16 * shownPage(seqIndex);
+        bool on = !seq.getStep(step);
+        seq.setStep(step, on);
+        journalEdit(EDIT_STEP, currentLayout, step, !on, on);
+        recordChange(CHANGE_STEP_TOGGLE, currentLayout, on ? 1 : 0, step);
 
         // Update LED for this step
-        if (seq.isStepSingleMode()) {
-            updateStepLEDSingle(stepIndex, seq);
-        } else {
-            bool isSeqA = stepIndex < 8;
-            updateStepLEDDual(stepIndex, seq, isSeqA);
+        markStepLED(stepIndex);
+        renderSequencerLEDs();
+    }
+
+    // Up/Down add/remove a step page, Left/Right show the previous/next page
+    void processPageButton(int cc) {
+        int s = currentLayout - 1;
+        const Sequencer& seq = engine.sequencers[s];
+        int page = shownPage(s);
+
+        switch (cc) {
+            case LCXL::BTN_UP: {
+                int oldPages = seq.pages;
+                engine.setPages(s, oldPages + 1);
+                journalEdit(EDIT_PAGES, currentLayout, 0, oldPages, seq.pages);
+                page = seq.pages - 1;  // Show the new page
+                break;
+            }
+            case LCXL::BTN_DOWN: {
+                // Removing a page clears its steps and conditions. They are journaled
+                // with the page count, so one undo brings the page back as it was.
+                Sequencer before = seq;
+                engine.setPages(s, seq.pages - 1);
+                if (seq.pages != before.pages) {
+                    journalEdit(EDIT_PAGES, currentLayout, 0, before.pages, seq.pages);
+                    journalStepEdits(currentLayout, before, true);
+                }
+                page = std::min(page, seq.pages - 1);
+                break;
+            }
+            case LCXL::BTN_LEFT:
+                page = std::max(page - 1, 0);
+                break;
+            case LCXL::BTN_RIGHT:
+                page = std::min(page + 1, seq.pages - 1);
+                break;
         }
+        viewPage[s] = page;
+        updateSequencerLEDs();
     }
 
     void switchLayout(int newLayout) {
@@ -1573,14 +2200,21 @@ struct Core : Module {
             return;
         }
 
-        currentLayout = newLayout;
-        recordChange(CHANGE_LAYOUT, newLayout, newLayout);
-
-        // Reset pickup state for all knobs
+        // A knob stays picked up in a layout as long as it hasn't been turned (beyond
+        // the ±2 pickup zone) while other layouts were active
         for (int i = 0; i < 24; i++) {
-            knobPickedUp[i] = false;
+            leftKnobPos[currentLayout][i] = lastPhysicalKnobPos[i];
+
+            int leftPos = leftKnobPos[newLayout][i];
+            if (leftPos < 0 || lastPhysicalKnobPos[i] < 0 || std::abs(lastPhysicalKnobPos[i] - leftPos) > 2) {
+                knobPickedUp[newLayout][i] = false;
+            }
         }
 
+        currentLayout = newLayout;
+        journal.seal();  // Coming back to a layout starts a new knob turn
+        recordChange(CHANGE_LAYOUT, newLayout, newLayout);
+
         // Update LEDs - but if Device is still held, show selection instead
         if (deviceButtonHeld) {
             showLayoutSelectionLEDs();
@@ -1590,22 +2224,7 @@ struct Core : Module {
     }
 
     void updateKnobLED(int knobIndex) {
-        int storedValue = knobValues[currentLayout][knobIndex];
-        int physicalPos = lastPhysicalKnobPos[knobIndex];
-
-        uint8_t color;
-        if (physicalPos < 0) {
-            // Unknown physical position - assume picked up until we receive MIDI
-            color = LCXL::LED_GREEN_FULL;
-        } else if (knobPickedUp[knobIndex] || std::abs(physicalPos - storedValue) <= 2) {
-            color = LCXL::LED_GREEN_FULL;
-        } else if (physicalPos < storedValue) {
-            color = LCXL::LED_YELLOW_FULL;
-        } else {
-            color = LCXL::LED_RED_FULL;
-        }
-
-        sendKnobLEDSysEx(knobIndex, color);
+        sendKnobLEDSysEx(knobIndex, LCXL::TAKEOVER_PALETTE[getPickupState(knobIndex)][1]);
     }
 
     void updateButtonLED(int buttonIndex, bool on) {
@@ -1644,19 +2263,10 @@ struct Core : Module {
         if (lastLEDState[knobIndex] == color) return;
         lastLEDState[knobIndex] = color;
 
-        // SysEx: F0 00 20 29 02 11 78 [template] [index] [color] F7
-        // Template 8 = Factory Template 1
-        midi::Message msg;
-        msg.bytes = {
-            0xF0,
-            0x00, 0x20, 0x29, 0x02, 0x11,
-            0x78,  // LED command (120 decimal)
-            0x08,  // Template 8 (Factory Template 1)
-            static_cast<uint8_t>(knobIndex),
-            color,
-            0xF7
-        };
-        midiOutput.sendMessage(msg);
+        // Batched with other LED changes into one SysEx by the device queue
+        if (device) {
+            ledQueue.queue(knobIndex, color);
+        }
     }
 
     void sendButtonLEDSysEx(int buttonIndex, uint8_t color) {
@@ -1674,28 +2284,9 @@ struct Core : Module {
         if (lastLEDState[ledIndex] == color) return;
         lastLEDState[ledIndex] = color;
 
-        midi::Message msg;
-        msg.bytes = {
-            0xF0,
-            0x00, 0x20, 0x29, 0x02, 0x11,
-            0x78,  // LED command (120 decimal)
-            0x08,  // Template 8 (Factory Template 1)
-            ledIndex,
-            color,
-            0xF7
-        };
-        midiOutput.sendMessage(msg);
-    }
-
-    void sendResetLEDs() {
-        // Reset command: B8 00 00 (176+8, 0, 0)
-        // This clears all LEDs on template 8 (Factory Template 1)
-        midi::Message msg;
-        msg.bytes = {0xB8, 0x00, 0x00};  // CC channel 9, CC 0, value 0
-        midiOutput.sendMessage(msg);
-
-        // Invalidate LED state cache so next update sends all LEDs
-        std::memset(lastLEDState, 0xFF, sizeof(lastLEDState));
+        if (device) {
+            ledQueue.queue(ledIndex, color);
+        }
     }
 
     json_t* dataToJson() override {
@@ -1704,10 +2295,18 @@ struct Core : Module {
         // Save MIDI settings
         json_object_set_new(rootJ, "midiInput", midiInput.toJson());
         json_object_set_new(rootJ, "midiOutput", midiOutput.toJson());
+        json_object_set_new(rootJ, "midiClockInput", clockInput.toJson());
+        json_object_set_new(rootJ, "deviceTemplate", json_integer(deviceTemplate));
 
         // Save current layout
         json_object_set_new(rootJ, "currentLayout", json_integer(currentLayout));
         json_object_set_new(rootJ, "outputLayout", json_integer(outputLayout));
+        json_object_set_new(rootJ, "ledLookahead", json_real(ledLookahead));
+        json_object_set_new(rootJ, "controlRateDivision", json_integer(controlRateDivision));
+        json_object_set_new(rootJ, "morphFader", json_integer(morphFader));
+        json_object_set_new(rootJ, "morphFrom", json_integer(morphFrom));
+        json_object_set_new(rootJ, "morphTo", json_integer(morphTo));
+        json_object_set_new(rootJ, "morphSequencer", json_integer(morphSequencer));
 
         // Save fader values
         json_t* fadersJ = json_array();
@@ -1747,61 +2346,101 @@ struct Core : Module {
             json_t* seqJ = json_object();
 
             // Save steps
-            json_t* stepsJ = json_array();
-            for (int i = 0; i < 16; i++) {
-                json_array_append_new(stepsJ, json_boolean(sequencers[s].steps[i]));
-            }
-            json_object_set_new(seqJ, "steps", stepsJ);
+            json_object_set_new(seqJ, "steps", stepsToJson(engine.sequencers[s].steps, engine.sequencers[s].pages));
+            json_object_set_new(seqJ, "conditions", conditionsToJson(engine.sequencers[s].conditionSteps, engine.sequencers[s].pages));
 
             // Save lengths
-            json_object_set_new(seqJ, "valueLengthA", json_integer(sequencers[s].valueLengthA));
-            json_object_set_new(seqJ, "valueLengthB", json_integer(sequencers[s].valueLengthB));
-            json_object_set_new(seqJ, "stepLengthA", json_integer(sequencers[s].stepLengthA));
-            json_object_set_new(seqJ, "stepLengthB", json_integer(sequencers[s].stepLengthB));
+            json_object_set_new(seqJ, "valueLengthA", json_integer(engine.sequencers[s].valueLengthA));
+            json_object_set_new(seqJ, "valueLengthB", json_integer(engine.sequencers[s].valueLengthB));
+            json_object_set_new(seqJ, "stepLengthA", json_integer(engine.sequencers[s].stepLengthA));
+            json_object_set_new(seqJ, "stepLengthB", json_integer(engine.sequencers[s].stepLengthB));
 
             // Save bias and per-sequencer CV values
-            json_object_set_new(seqJ, "bias", json_real(sequencers[s].bias));
-            json_object_set_new(seqJ, "cv1", json_integer(sequencers[s].cv1));
-            json_object_set_new(seqJ, "cv2", json_integer(sequencers[s].cv2));
-            json_object_set_new(seqJ, "cv3", json_integer(sequencers[s].cv3));
+            json_object_set_new(seqJ, "bias", json_real(engine.sequencers[s].bias));
+            json_object_set_new(seqJ, "density", json_real(engine.sequencers[s].density));
+            json_object_set_new(seqJ, "cv1", json_integer(engine.sequencers[s].cv1));
+            json_object_set_new(seqJ, "cv2", json_integer(engine.sequencers[s].cv2));
+            json_object_set_new(seqJ, "cv3", json_integer(engine.sequencers[s].cv3));
 
             // Save modes
-            json_object_set_new(seqJ, "competitionMode", json_integer(sequencers[s].competitionMode));
-            json_object_set_new(seqJ, "routingMode", json_integer(sequencers[s].routingMode));
+            json_object_set_new(seqJ, "competitionMode", json_integer(engine.sequencers[s].competitionMode));
+            json_object_set_new(seqJ, "routingMode", json_integer(engine.sequencers[s].routingMode));
 
             // Save voltage settings
-            json_object_set_new(seqJ, "voltageRangeA", json_integer(sequencers[s].voltageRangeA));
-            json_object_set_new(seqJ, "voltageRangeB", json_integer(sequencers[s].voltageRangeB));
-            json_object_set_new(seqJ, "bipolarA", json_boolean(sequencers[s].bipolarA));
-            json_object_set_new(seqJ, "bipolarB", json_boolean(sequencers[s].bipolarB));
+            json_object_set_new(seqJ, "voltageRangeA", json_integer(engine.sequencers[s].voltageRangeA));
+            json_object_set_new(seqJ, "voltageRangeB", json_integer(engine.sequencers[s].voltageRangeB));
+            json_object_set_new(seqJ, "bipolarA", json_boolean(engine.sequencers[s].bipolarA));
+            json_object_set_new(seqJ, "bipolarB", json_boolean(engine.sequencers[s].bipolarB));
 
             // Save glide times
             json_t* glideJ = json_array();
             for (int i = 0; i < 16; i++) {
-                json_array_append_new(glideJ, json_integer(sequencers[s].glideTime[i]));
+                json_array_append_new(glideJ, json_integer(engine.sequencers[s].glideTime[i]));
             }
             json_object_set_new(seqJ, "glideTime", glideJ);
 
+            // Save trigger timing
+            json_object_set_new(seqJ, "ratchets", json_integer(engine.sequencers[s].ratchets));
+            json_object_set_new(seqJ, "swing", json_real(engine.sequencers[s].swing));
+            json_object_set_new(seqJ, "gateLength", json_real(engine.sequencers[s].gateLength));
+            json_object_set_new(seqJ, "midiClockDivision", json_integer(engine.sequencers[s].midiClockDivision));
+
             json_array_append_new(seqsJ, seqJ);
         }
         json_object_set_new(rootJ, "sequencers", seqsJ);
 
+        // Save pattern banks (the live pattern is saved above)
+        json_t* banksJ = json_array();
+        for (int s = 0; s < 8; s++) {
+            const PatternBank& bank = engine.banks[s];
+            json_t* bankJ = json_object();
+            json_object_set_new(bankJ, "active", json_integer(bank.active));
+            json_t* patternsJ = json_array();
+            for (int p = 0; p < PatternBank::SIZE; p++) {
+                json_array_append_new(patternsJ, patternToJson(bank.patterns[p]));
+            }
+            json_object_set_new(bankJ, "patterns", patternsJ);
+            json_array_append_new(banksJ, bankJ);
+        }
+        json_object_set_new(rootJ, "patternBanks", banksJ);
+
         return rootJ;
     }
 
     void dataFromJson(json_t* rootJ) override {
+        journal.clear();
+
         // Load MIDI settings
         json_t* midiInputJ = json_object_get(rootJ, "midiInput");
         if (midiInputJ) midiInput.fromJson(midiInputJ);
 
         json_t* midiOutputJ = json_object_get(rootJ, "midiOutput");
         if (midiOutputJ) midiOutput.fromJson(midiOutputJ);
+        json_t* midiClockInputJ = json_object_get(rootJ, "midiClockInput");
+        if (midiClockInputJ) clockInput.fromJson(midiClockInputJ);
+        json_t* templateJ = json_object_get(rootJ, "deviceTemplate");
+        if (templateJ) deviceTemplate = clamp((int) json_integer_value(templateJ), LCXL::FACTORY_TEMPLATE_1, 15);
+        midiInput.channel = deviceTemplate;
 
         // Load current layout
         json_t* layoutJ = json_object_get(rootJ, "currentLayout");
         if (layoutJ) currentLayout = json_integer_value(layoutJ);
         json_t* outLayoutJ = json_object_get(rootJ, "outputLayout");
         if (outLayoutJ) outputLayout = json_integer_value(outLayoutJ);
+        json_t* lookaheadJ = json_object_get(rootJ, "ledLookahead");
+        if (lookaheadJ) ledLookahead = json_real_value(lookaheadJ);
+        json_t* controlRateJ = json_object_get(rootJ, "controlRateDivision");
+        if (controlRateJ) setControlRateDivision(json_integer_value(controlRateJ));
+        json_t* morphFaderJ = json_object_get(rootJ, "morphFader");
+        json_t* morphFromJ = json_object_get(rootJ, "morphFrom");
+        json_t* morphToJ = json_object_get(rootJ, "morphTo");
+        json_t* morphSeqJ = json_object_get(rootJ, "morphSequencer");
+        if (morphFaderJ && morphFromJ && morphToJ && morphSeqJ) {
+            setMorph(clamp((int) json_integer_value(morphFaderJ), -1, 7),
+                     clamp((int) json_integer_value(morphFromJ), 0, 8),
+                     clamp((int) json_integer_value(morphToJ), 0, 8),
+                     clamp((int) json_integer_value(morphSeqJ), 0, 8));
+        }
 
         // Load fader values
         json_t* fadersJ = json_object_get(rootJ, "faders");
@@ -1824,6 +2463,7 @@ struct Core : Module {
                     }
                 }
             }
+            knobRevision++;
         }
 
         // Load button states
@@ -1833,6 +2473,7 @@ struct Core : Module {
                 json_t* valJ = json_array_get(buttonsJ, i);
                 if (valJ) buttonStates[i] = json_boolean_value(valJ);
             }
+            buttonRevision++;
         }
 
         // Load button momentary modes
@@ -1853,60 +2494,187 @@ struct Core : Module {
                     // Load steps
                     json_t* stepsJ = json_object_get(seqJ, "steps");
                     if (stepsJ) {
-                        for (int i = 0; i < 16; i++) {
-                            json_t* valJ = json_array_get(stepsJ, i);
-                            if (valJ) sequencers[s].steps[i] = json_boolean_value(valJ);
-                        }
+                        engine.sequencers[s].pages = stepsFromJson(stepsJ, &engine.sequencers[s].steps);
                     }
+                    conditionsFromJson(json_object_get(seqJ, "conditions"), engine.sequencers[s].conditionSteps);
+                    engine.evaluateConditions(s, ~0ull);
 
                     // Load lengths
                     json_t* vlA = json_object_get(seqJ, "valueLengthA");
-                    if (vlA) sequencers[s].valueLengthA = json_integer_value(vlA);
+                    if (vlA) engine.sequencers[s].valueLengthA = json_integer_value(vlA);
                     json_t* vlB = json_object_get(seqJ, "valueLengthB");
-                    if (vlB) sequencers[s].valueLengthB = json_integer_value(vlB);
+                    if (vlB) engine.sequencers[s].valueLengthB = json_integer_value(vlB);
                     json_t* slA = json_object_get(seqJ, "stepLengthA");
-                    if (slA) sequencers[s].stepLengthA = json_integer_value(slA);
+                    if (slA) engine.sequencers[s].stepLengthA = json_integer_value(slA);
                     json_t* slB = json_object_get(seqJ, "stepLengthB");
-                    if (slB) sequencers[s].stepLengthB = json_integer_value(slB);
+                    if (slB) engine.sequencers[s].stepLengthB = json_integer_value(slB);
+                    engine.clampLengths(s);
 
                     // Load bias and per-sequencer CV values
                     json_t* biasJ = json_object_get(seqJ, "bias");
-                    if (biasJ) sequencers[s].bias = json_real_value(biasJ);
+                    if (biasJ) engine.sequencers[s].bias = json_real_value(biasJ);
+                    json_t* densityJ = json_object_get(seqJ, "density");
+                    if (densityJ) engine.sequencers[s].density = clamp((float) json_real_value(densityJ), 0.f, 1.f);
                     json_t* cv1J = json_object_get(seqJ, "cv1");
-                    if (cv1J) sequencers[s].cv1 = json_integer_value(cv1J);
+                    if (cv1J) engine.sequencers[s].cv1 = json_integer_value(cv1J);
                     json_t* cv2J = json_object_get(seqJ, "cv2");
-                    if (cv2J) sequencers[s].cv2 = json_integer_value(cv2J);
+                    if (cv2J) engine.sequencers[s].cv2 = json_integer_value(cv2J);
                     json_t* cv3J = json_object_get(seqJ, "cv3");
-                    if (cv3J) sequencers[s].cv3 = json_integer_value(cv3J);
+                    if (cv3J) engine.sequencers[s].cv3 = json_integer_value(cv3J);
 
                     // Load modes
                     json_t* compMode = json_object_get(seqJ, "competitionMode");
-                    if (compMode) sequencers[s].competitionMode = json_integer_value(compMode);
+                    if (compMode) engine.setCompetitionMode(s, json_integer_value(compMode));
                     json_t* routMode = json_object_get(seqJ, "routingMode");
-                    if (routMode) sequencers[s].routingMode = json_integer_value(routMode);
+                    if (routMode) engine.setRoutingMode(s, json_integer_value(routMode));
 
                     // Load voltage settings
                     json_t* vrA = json_object_get(seqJ, "voltageRangeA");
-                    if (vrA) sequencers[s].voltageRangeA = json_integer_value(vrA);
+                    if (vrA) engine.sequencers[s].voltageRangeA = json_integer_value(vrA);
                     json_t* vrB = json_object_get(seqJ, "voltageRangeB");
-                    if (vrB) sequencers[s].voltageRangeB = json_integer_value(vrB);
+                    if (vrB) engine.sequencers[s].voltageRangeB = json_integer_value(vrB);
                     json_t* bpA = json_object_get(seqJ, "bipolarA");
-                    if (bpA) sequencers[s].bipolarA = json_boolean_value(bpA);
+                    if (bpA) engine.sequencers[s].bipolarA = json_boolean_value(bpA);
                     json_t* bpB = json_object_get(seqJ, "bipolarB");
-                    if (bpB) sequencers[s].bipolarB = json_boolean_value(bpB);
+                    if (bpB) engine.sequencers[s].bipolarB = json_boolean_value(bpB);
 
                     // Load glide times
                     json_t* glideJ = json_object_get(seqJ, "glideTime");
                     if (glideJ) {
                         for (int i = 0; i < 16; i++) {
                             json_t* valJ = json_array_get(glideJ, i);
-                            if (valJ) sequencers[s].glideTime[i] = json_integer_value(valJ);
+                            if (valJ) engine.sequencers[s].glideTime[i] = json_integer_value(valJ);
                         }
                     }
+
+                    // Load trigger timing
+                    json_t* ratchetsJ = json_object_get(seqJ, "ratchets");
+                    if (ratchetsJ) engine.sequencers[s].ratchets = clamp((int) json_integer_value(ratchetsJ), 1, 4);
+                    json_t* swingJ = json_object_get(seqJ, "swing");
+                    if (swingJ) engine.sequencers[s].swing = clamp((float) json_real_value(swingJ), 0.5f, 0.71f);
+                    json_t* gateJ = json_object_get(seqJ, "gateLength");
+                    if (gateJ) engine.sequencers[s].gateLength = clamp((float) json_real_value(gateJ), 0.f, 1.f);
+                    json_t* divisionJ = json_object_get(seqJ, "midiClockDivision");
+                    if (divisionJ) engine.sequencers[s].midiClockDivision = clamp((int) json_integer_value(divisionJ), 1, 96);
+                }
+            }
+        }
+
+        // Load pattern banks
+        json_t* banksJ = json_object_get(rootJ, "patternBanks");
+        if (banksJ) {
+            for (int s = 0; s < 8; s++) {
+                json_t* bankJ = json_array_get(banksJ, s);
+                if (!bankJ) continue;
+                PatternBank& bank = engine.banks[s];
+                json_t* activeJ = json_object_get(bankJ, "active");
+                if (activeJ) bank.active = clamp((int) json_integer_value(activeJ), 0, PatternBank::SIZE - 1);
+                bank.queued = -1;
+                json_t* patternsJ = json_object_get(bankJ, "patterns");
+                for (int p = 0; patternsJ && p < PatternBank::SIZE; p++) {
+                    json_t* patternJ = json_array_get(patternsJ, p);
+                    if (patternJ) patternFromJson(patternJ, &bank.patterns[p]);
                 }
             }
         }
     }
+
+    static json_t* intArrayToJson(const int* values, int count) {
+        json_t* arrayJ = json_array();
+        for (int i = 0; i < count; i++) {
+            json_array_append_new(arrayJ, json_integer(values[i]));
+        }
+        return arrayJ;
+    }
+
+    static void intArrayFromJson(json_t* arrayJ, int* values, int count) {
+        if (!arrayJ) return;
+        for (int i = 0; i < count; i++) {
+            json_t* valJ = json_array_get(arrayJ, i);
+            if (valJ) values[i] = json_integer_value(valJ);
+        }
+    }
+
+    // Steps as an array of pages * 16 booleans
+    static json_t* stepsToJson(uint64_t steps, int pages) {
+        json_t* stepsJ = json_array();
+        for (int i = 0; i < 16 * pages; i++) {
+            json_array_append_new(stepsJ, json_boolean((steps >> i) & 1));
+        }
+        return stepsJ;
+    }
+
+    // Read a steps array, returns its number of pages
+    static int stepsFromJson(json_t* stepsJ, uint64_t* steps) {
+        int count = std::min((int) json_array_size(stepsJ), (int) Sequencer::MAX_STEPS);
+        *steps = 0;
+        for (int i = 0; i < count; i++) {
+            if (json_boolean_value(json_array_get(stepsJ, i))) *steps |= 1ull << i;
+        }
+        return std::max(1, (count + 15) / 16);
+    }
+
+    // Trig conditions as an array of one StepCondition per step
+    static json_t* conditionsToJson(const uint64_t* conditionSteps, int pages) {
+        json_t* conditionsJ = json_array();
+        for (int i = 0; i < 16 * pages; i++) {
+            int condition = COND_ALWAYS;
+            for (int c = 1; c < NUM_CONDITIONS; c++) {
+                if ((conditionSteps[c - 1] >> i) & 1) condition = c;
+            }
+            json_array_append_new(conditionsJ, json_integer(condition));
+        }
+        return conditionsJ;
+    }
+
+    static void conditionsFromJson(json_t* conditionsJ, uint64_t* conditionSteps) {
+        std::fill(conditionSteps, conditionSteps + NUM_CONDITIONS - 1, 0ull);
+        int count = std::min((int) json_array_size(conditionsJ), (int) Sequencer::MAX_STEPS);
+        for (int i = 0; i < count; i++) {
+            int condition = json_integer_value(json_array_get(conditionsJ, i));
+            if (condition > COND_ALWAYS && condition < NUM_CONDITIONS) {
+                conditionSteps[condition - 1] |= 1ull << i;
+            }
+        }
+    }
+
+    static json_t* patternToJson(const Pattern& pattern) {
+        json_t* patternJ = json_object();
+        json_object_set_new(patternJ, "steps", stepsToJson(pattern.steps, pattern.pages));
+        json_object_set_new(patternJ, "conditions", conditionsToJson(pattern.conditionSteps, pattern.pages));
+        json_object_set_new(patternJ, "valueLengthA", json_integer(pattern.valueLengthA));
+        json_object_set_new(patternJ, "valueLengthB", json_integer(pattern.valueLengthB));
+        json_object_set_new(patternJ, "stepLengthA", json_integer(pattern.stepLengthA));
+        json_object_set_new(patternJ, "stepLengthB", json_integer(pattern.stepLengthB));
+        json_object_set_new(patternJ, "competitionMode", json_integer(pattern.competitionMode));
+        json_object_set_new(patternJ, "routingMode", json_integer(pattern.routingMode));
+        json_object_set_new(patternJ, "glideTime", intArrayToJson(pattern.glideTime, 16));
+        json_object_set_new(patternJ, "knobs", intArrayToJson(pattern.knobs, 24));
+        json_object_set_new(patternJ, "density", json_real(pattern.density));
+        return patternJ;
+    }
+
+    static void patternFromJson(json_t* patternJ, Pattern* pattern) {
+        json_t* stepsJ = json_object_get(patternJ, "steps");
+        if (stepsJ) pattern->pages = stepsFromJson(stepsJ, &pattern->steps);
+        conditionsFromJson(json_object_get(patternJ, "conditions"), pattern->conditionSteps);
+        json_t* vlA = json_object_get(patternJ, "valueLengthA");
+        if (vlA) pattern->valueLengthA = clamp((int) json_integer_value(vlA), 1, 16);
+        json_t* vlB = json_object_get(patternJ, "valueLengthB");
+        if (vlB) pattern->valueLengthB = clamp((int) json_integer_value(vlB), 0, 8);
+        json_t* slA = json_object_get(patternJ, "stepLengthA");
+        if (slA) pattern->stepLengthA = clamp((int) json_integer_value(slA), 1, 16 * pattern->pages);
+        json_t* slB = json_object_get(patternJ, "stepLengthB");
+        if (slB) pattern->stepLengthB = clamp((int) json_integer_value(slB), 0, 8);
+        json_t* compMode = json_object_get(patternJ, "competitionMode");
+        if (compMode) pattern->competitionMode = json_integer_value(compMode);
+        json_t* routMode = json_object_get(patternJ, "routingMode");
+        if (routMode) pattern->routingMode = json_integer_value(routMode);
+        intArrayFromJson(json_object_get(patternJ, "glideTime"), pattern->glideTime, 16);
+        intArrayFromJson(json_object_get(patternJ, "knobs"), pattern->knobs, 24);
+        json_t* densityJ = json_object_get(patternJ, "density");
+        if (densityJ) pattern->density = clamp((float) json_real_value(densityJ), 0.f, 1.f);
+    }
 };
 
 // Simple label widget for panel text
@@ -1945,58 +2713,71 @@ struct CoreWidget : ModuleWidget {
         addChild(createWidget<ScrewSilver>(Vec(box.size.x - 2 * RACK_GRID_WIDTH, RACK_GRID_HEIGHT - RACK_GRID_WIDTH)));
 
         // Connected light (MIDI status) - positioned like expanders
-        addChild(createLightCentered<SmallLight<GreenLight>>(mm2px(Vec(5, 10)), module, Core::CONNECTED_LIGHT));
+        addChild(createLightCentered<SmallLight<GreenLight>>(mm2px(Vec(6.35, 10)), module, Core::CONNECTED_LIGHT));
 
         // Takeover button with light - positioned near connected light
-        addParam(createParamCentered<VCVButton>(mm2px(Vec(20, 10)), module, Core::TAKEOVER_PARAM));
-        addChild(createLightCentered<SmallLight<GreenLight>>(mm2px(Vec(35, 10)), module, Core::TAKEOVER_LIGHT));
+        addParam(createParamCentered<VCVButton>(mm2px(Vec(25.4, 10)), module, Core::TAKEOVER_PARAM));
+        addChild(createLightCentered<SmallLight<GreenLight>>(mm2px(Vec(44.45, 10)), module, Core::TAKEOVER_LIGHT));
 
         // Column labels (like expanders)
-        addChild(createLabel(mm2px(Vec(0, 14)), mm2px(Vec(20, 4)), "CLK/RST", 7.f));
-        addChild(createLabel(mm2px(Vec(20, 14)), mm2px(Vec(20, 4)), "SEQ OUT", 7.f));
+        addChild(createLabel(mm2px(Vec(2.7, 14)), mm2px(Vec(20, 4)), "CLK/RST", 7.f));
+        addChild(createLabel(mm2px(Vec(28.1, 14)), mm2px(Vec(20, 4)), "SEQ OUT", 7.f));
 
         // Clock and Reset inputs (left column) - starting at y=22 like expanders
-        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(10, 22)), module, Core::CLOCK_A_INPUT));
-        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(10, 32)), module, Core::CLOCK_B_INPUT));
-        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(10, 42)), module, Core::RESET_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(12.7, 22)), module, Core::CLOCK_A_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(12.7, 32)), module, Core::CLOCK_B_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(12.7, 42)), module, Core::RESET_INPUT));
 
         // Sequencer outputs (right column) - starting at y=22 like expanders
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30, 22)), module, Core::SEQ_TRIG_A_OUTPUT));
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30, 32)), module, Core::SEQ_CV_A_OUTPUT));
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30, 42)), module, Core::SEQ_TRIG_B_OUTPUT));
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30, 52)), module, Core::SEQ_CV_B_OUTPUT));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.1, 22)), module, Core::SEQ_TRIG_A_OUTPUT));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.1, 32)), module, Core::SEQ_CV_A_OUTPUT));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.1, 42)), module, Core::SEQ_TRIG_B_OUTPUT));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.1, 52)), module, Core::SEQ_CV_B_OUTPUT));
 
         // Row labels for inputs/outputs
-        addChild(createLabel(mm2px(Vec(15, 20)), mm2px(Vec(10, 4)), "A", 6.f));
-        addChild(createLabel(mm2px(Vec(15, 30)), mm2px(Vec(10, 4)), "B", 6.f));
-        addChild(createLabel(mm2px(Vec(15, 40)), mm2px(Vec(10, 4)), "RST", 6.f));
-        addChild(createLabel(mm2px(Vec(15, 50)), mm2px(Vec(10, 4)), "CV B", 6.f));
+        addChild(createLabel(mm2px(Vec(20.4, 20)), mm2px(Vec(10, 4)), "A", 6.f));
+        addChild(createLabel(mm2px(Vec(20.4, 30)), mm2px(Vec(10, 4)), "B", 6.f));
+        addChild(createLabel(mm2px(Vec(20.4, 40)), mm2px(Vec(10, 4)), "RST", 6.f));
+        addChild(createLabel(mm2px(Vec(20.4, 50)), mm2px(Vec(10, 4)), "CV B", 6.f));
+
+        // Sequencer parameter modulation inputs (one channel per sequencer), on the
+        // MOD band of the panel: 10mm apart, labels below the jacks
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(5.4, 61)), module, Core::MOD_BIAS_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(15.4, 61)), module, Core::MOD_STEP_LENGTH_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(25.4, 61)), module, Core::MOD_VALUE_LENGTH_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(35.4, 61)), module, Core::MOD_CV_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(45.4, 61)), module, Core::MOD_DENSITY_INPUT));
+        addChild(createLabel(mm2px(Vec(0.9, 65.4)), mm2px(Vec(9, 2.8)), "BIAS", 5.f));
+        addChild(createLabel(mm2px(Vec(10.9, 65.4)), mm2px(Vec(9, 2.8)), "STEP", 5.f));
+        addChild(createLabel(mm2px(Vec(20.9, 65.4)), mm2px(Vec(9, 2.8)), "VAL", 5.f));
+        addChild(createLabel(mm2px(Vec(30.9, 65.4)), mm2px(Vec(9, 2.8)), "CV", 5.f));
+        addChild(createLabel(mm2px(Vec(40.9, 65.4)), mm2px(Vec(9, 2.8)), "DENS", 5.f));
 
         // Faders section header
-        addChild(createLabel(mm2px(Vec(10, 60)), mm2px(Vec(20, 5)), "FADERS", 8.f));
+        addChild(createLabel(mm2px(Vec(15.4, 69.5)), mm2px(Vec(20, 4)), "FADERS", 7.f));
 
         // Fader outputs (bottom section, two columns)
         // Column 1: Faders 1-4
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(10, 70)), module, Core::FADER_OUTPUT_1));
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(10, 80)), module, Core::FADER_OUTPUT_1 + 1));
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(10, 90)), module, Core::FADER_OUTPUT_1 + 2));
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(10, 100)), module, Core::FADER_OUTPUT_1 + 3));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(12.7, 77.5)), module, Core::FADER_OUTPUT_1));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(12.7, 86.5)), module, Core::FADER_OUTPUT_1 + 1));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(12.7, 95.5)), module, Core::FADER_OUTPUT_1 + 2));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(12.7, 104.5)), module, Core::FADER_OUTPUT_1 + 3));
         // Column 2: Faders 5-8
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30, 70)), module, Core::FADER_OUTPUT_1 + 4));
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30, 80)), module, Core::FADER_OUTPUT_1 + 5));
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30, 90)), module, Core::FADER_OUTPUT_1 + 6));
-        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30, 100)), module, Core::FADER_OUTPUT_1 + 7));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.1, 77.5)), module, Core::FADER_OUTPUT_1 + 4));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.1, 86.5)), module, Core::FADER_OUTPUT_1 + 5));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.1, 95.5)), module, Core::FADER_OUTPUT_1 + 6));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.1, 104.5)), module, Core::FADER_OUTPUT_1 + 7));
 
         // Fader row numbers (between columns)
-        addChild(createLabel(mm2px(Vec(15, 68)), mm2px(Vec(10, 4)), "1    5", 6.f));
-        addChild(createLabel(mm2px(Vec(15, 78)), mm2px(Vec(10, 4)), "2    6", 6.f));
-        addChild(createLabel(mm2px(Vec(15, 88)), mm2px(Vec(10, 4)), "3    7", 6.f));
-        addChild(createLabel(mm2px(Vec(15, 98)), mm2px(Vec(10, 4)), "4    8", 6.f));
+        addChild(createLabel(mm2px(Vec(20.4, 75.5)), mm2px(Vec(10, 4)), "1    5", 6.f));
+        addChild(createLabel(mm2px(Vec(20.4, 84.5)), mm2px(Vec(10, 4)), "2    6", 6.f));
+        addChild(createLabel(mm2px(Vec(20.4, 93.5)), mm2px(Vec(10, 4)), "3    7", 6.f));
+        addChild(createLabel(mm2px(Vec(20.4, 102.5)), mm2px(Vec(10, 4)), "4    8", 6.f));
 
         // Module name at bottom
-        addChild(createLabel(mm2px(Vec(10, 110)), mm2px(Vec(20, 8)), "COR", 14.f));
+        addChild(createLabel(mm2px(Vec(15.4, 110)), mm2px(Vec(20, 8)), "COR", 14.f));
         // Brand below line
-        addChild(createLabel(mm2px(Vec(10, 120)), mm2px(Vec(20, 8)), "LCXL", 14.f));
+        addChild(createLabel(mm2px(Vec(15.4, 120)), mm2px(Vec(20, 8)), "LCXL", 14.f));
     }
 
     void appendContextMenu(Menu* menu) override {
@@ -2005,12 +2786,33 @@ struct CoreWidget : ModuleWidget {
 
         menu->addChild(new MenuSeparator);
         menu->addChild(createMenuLabel("MIDI Input"));
-        app::appendMidiMenu(menu, &module->midiInput);
+        appendMidiPortMenu(menu, &module->midiInput);
 
         menu->addChild(new MenuSeparator);
         menu->addChild(createMenuLabel("MIDI Output"));
         app::appendMidiMenu(menu, &module->midiOutput);
 
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createMenuLabel("MIDI Clock Input (replaces CLK A/B)"));
+        app::appendMidiMenu(menu, &module->clockInput);
+
+        // Each Core on the same controller uses its own factory template
+        menu->addChild(createSubmenuItem("Device Template", string::f("Factory %d", module->deviceTemplate - LCXL::FACTORY_TEMPLATE_1 + 1), [=](Menu* menu) {
+            for (int i = 0; i < LCXL::NUM_FACTORY_TEMPLATES; i++) {
+                int tmpl = LCXL::FACTORY_TEMPLATE_1 + i;
+                menu->addChild(createCheckMenuItem(string::f("Factory %d (channel %d)", i + 1, tmpl + 1), "",
+                    [=]() { return module->deviceTemplate == tmpl; },
+                    [=]() { module->setDeviceTemplate(tmpl); }
+                ));
+            }
+        }));
+
+#ifdef VIRTUAL_LCXL
+        if (module->midiOutput.getDriverId() == VirtualLCXL::DRIVER_ID) {
+            appendVirtualControllerMenu(menu);
+        }
+#endif
+
         menu->addChild(new MenuSeparator);
         menu->addChild(createMenuLabel("Sequencer Output"));
 
@@ -2027,7 +2829,272 @@ struct CoreWidget : ModuleWidget {
                 [=]() { module->outputLayout = i; }
             ));
         }
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createMenuLabel("Trigger Timing"));
+
+        // Per-sequencer ratchets, swing and gate length
+        for (int s = 0; s < 8; s++) {
+            menu->addChild(createSubmenuItem(string::f("Sequencer %d", s + 1), "", [=](Menu* menu) {
+                Sequencer* seq = &module->engine.sequencers[s];
+
+                menu->addChild(createMenuLabel("Ratchets"));
+                for (int r = 1; r <= 4; r++) {
+                    menu->addChild(createCheckMenuItem(string::f("%dx", r), "",
+                        [=]() { return seq->ratchets == r; },
+                        [=]() { seq->ratchets = r; }
+                    ));
+                }
+
+                menu->addChild(new MenuSeparator);
+                menu->addChild(createMenuLabel("Swing"));
+                static const float swings[] = {0.5f, 0.54f, 0.58f, 0.62f, 0.66f, 0.71f};
+                for (int i = 0; i < 6; i++) {
+                    float sw = swings[i];
+                    menu->addChild(createCheckMenuItem(i == 0 ? "50% (straight)" : string::f("%d%%", (int) std::round(sw * 100.f)), "",
+                        [=]() { return seq->swing == sw; },
+                        [=]() { seq->swing = sw; }
+                    ));
+                }
+
+                menu->addChild(new MenuSeparator);
+                menu->addChild(createMenuLabel("Gate Length"));
+                static const float gates[] = {0.f, 0.25f, 0.5f, 0.75f};
+                static const char* gateLabels[] = {"Trigger (1 ms)", "25%", "50%", "75%"};
+                for (int i = 0; i < 4; i++) {
+                    float g = gates[i];
+                    menu->addChild(createCheckMenuItem(gateLabels[i], "",
+                        [=]() { return seq->gateLength == g; },
+                        [=]() { seq->gateLength = g; }
+                    ));
+                }
+
+                menu->addChild(new MenuSeparator);
+                menu->addChild(createMenuLabel("MIDI Clock Step"));
+                static const int divisions[] = {24, 12, 8, 6, 4, 3};
+                static const char* divisionLabels[] = {"1/4", "1/8", "1/8 triplet", "1/16", "1/16 triplet", "1/32"};
+                for (int i = 0; i < 6; i++) {
+                    int d = divisions[i];
+                    menu->addChild(createCheckMenuItem(divisionLabels[i], string::f("%d ticks", d),
+                        [=]() { return seq->midiClockDivision == d; },
+                        [=]() { seq->midiClockDivision = d; }
+                    ));
+                }
+            }));
+        }
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createMenuLabel("LED Lookahead"));
+
+        // Send playhead LEDs ahead of the predicted clock to hide MIDI output latency
+        static const float lookaheadTimes[] = {0.f, 0.005f, 0.01f, 0.02f, 0.04f};
+        static const char* lookaheadLabels[] = {"Off", "5 ms", "10 ms", "20 ms", "40 ms"};
+        for (int i = 0; i < 5; i++) {
+            float t = lookaheadTimes[i];
+            menu->addChild(createCheckMenuItem(lookaheadLabels[i], "",
+                [=]() { return module->ledLookahead == t; },
+                [=]() { module->ledLookahead = t; }
+            ));
+        }
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createMenuLabel("Control Rate"));
+
+        // How often MIDI, LEDs and lights are processed (Core and all expanders).
+        // Clocks, triggers and CV slew always run at audio rate.
+        static const int divisions[] = {1, 16, 32, 64, 128};
+        for (int i = 0; i < 5; i++) {
+            int d = divisions[i];
+            menu->addChild(createCheckMenuItem(d == 1 ? "Every sample" : string::f("Every %d samples", d), "",
+                [=]() { return module->controlRateDivision == d; },
+                [=]() { module->setControlRateDivision(d); }
+            ));
+        }
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createMenuLabel("Layout Morph"));
+
+        // A fader crossfades every knob between two layouts
+        menu->addChild(createSubmenuItem("Morph fader", module->morphFader < 0 ? "Off" : string::f("Fader %d", module->morphFader + 1),
+            [=](Menu* menu) {
+                for (int f = -1; f < 8; f++) {
+                    menu->addChild(createCheckMenuItem(f < 0 ? "Off" : string::f("Fader %d", f + 1), "",
+                        [=]() { return module->morphFader == f; },
+                        [=]() { module->setMorph(f, module->morphFrom, module->morphTo, module->morphSequencer); }
+                    ));
+                }
+            }
+        ));
+
+        auto layoutName = [](int layout) {
+            return layout == 0 ? std::string("Default") : string::f("Seq %d", layout);
+        };
+        menu->addChild(createSubmenuItem("Morph from", layoutName(module->morphFrom),
+            [=](Menu* menu) {
+                for (int l = 0; l < 9; l++) {
+                    menu->addChild(createCheckMenuItem(layoutName(l), "",
+                        [=]() { return module->morphFrom == l; },
+                        [=]() { module->setMorph(module->morphFader, l, module->morphTo, module->morphSequencer); }
+                    ));
+                }
+            }
+        ));
+        menu->addChild(createSubmenuItem("Morph to", layoutName(module->morphTo),
+            [=](Menu* menu) {
+                for (int l = 0; l < 9; l++) {
+                    menu->addChild(createCheckMenuItem(layoutName(l), "",
+                        [=]() { return module->morphTo == l; },
+                        [=]() { module->setMorph(module->morphFader, module->morphFrom, l, module->morphSequencer); }
+                    ));
+                }
+            }
+        ));
+
+        // The chosen sequencer plays the morphed values instead of its own knobs
+        menu->addChild(createSubmenuItem("Apply to sequencer", module->morphSequencer == 0 ? "None" : string::f("Seq %d", module->morphSequencer),
+            [=](Menu* menu) {
+                for (int s = 0; s < 9; s++) {
+                    menu->addChild(createCheckMenuItem(s == 0 ? "None" : string::f("Seq %d", s), "",
+                        [=]() { return module->morphSequencer == s; },
+                        [=]() { module->setMorph(module->morphFader, module->morphFrom, module->morphTo, s); }
+                    ));
+                }
+            }
+        ));
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createMenuLabel("Controller Edits"));
+
+        // Edits made on the LCXL are not in Rack's undo history; they have their own
+        menu->addChild(createMenuItem("Undo", string::f("%d", module->journal.undoCount),
+            [=]() { module->undoRequests++; },
+            module->journal.undoCount == 0
+        ));
+        menu->addChild(createMenuItem("Redo", string::f("%d", module->journal.redoCount),
+            [=]() { module->redoRequests++; },
+            module->journal.redoCount == 0
+        ));
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createMenuLabel("Preset Library"));
+
+        if (!module->presetLibrary.isOpen()) {
+            menu->addChild(createMenuLabel("Library file unavailable"));
+            return;
+        }
+
+        // Store/clear any record; recall happens from the controller (Device + Solo + knobs 1-2)
+        for (int g = 0; g < PresetLibrary::CAPACITY / 16; g++) {
+            menu->addChild(createSubmenuItem(string::f("Presets %d-%d", g * 16 + 1, g * 16 + 16), "",
+                [=](Menu* menu) {
+                    for (int i = g * 16; i < g * 16 + 16; i++) {
+                        const PresetRecord* record = module->presetLibrary.get(i);
+                        bool used = record && record->used;
+                        menu->addChild(createSubmenuItem(string::f("Preset %d", i + 1), used ? "" : "empty",
+                            [=](Menu* menu) {
+                                for (int s = 0; s < 8; s++) {
+                                    menu->addChild(createMenuItem(string::f("Store Sequencer %d", s + 1), "",
+                                        [=]() { module->storePreset(s, i); }
+                                    ));
+                                }
+                                if (used) {
+                                    menu->addChild(createMenuItem("Clear", "",
+                                        [=]() { module->clearPreset(i); }
+                                    ));
+                                }
+                            }
+                        ));
+                    }
+                }
+            ));
+        }
+    }
+
+    // Driver and device of a MIDI port, without Rack's channel selector: the
+    // controller input's channel always follows the device template
+    static void appendMidiPortMenu(Menu* menu, midi::Port* port) {
+        std::string driverName = "(No driver)";
+        if (midi::Driver* driver = midi::getDriver(port->getDriverId())) driverName = driver->getName();
+        menu->addChild(createSubmenuItem("Driver", driverName, [=](Menu* menu) {
+            for (int driverId : midi::getDriverIds()) {
+                midi::Driver* driver = midi::getDriver(driverId);
+                menu->addChild(createCheckMenuItem(driver ? driver->getName() : "", "",
+                    [=]() { return port->getDriverId() == driverId; },
+                    [=]() { port->setDriverId(driverId); }
+                ));
+            }
+        }));
+
+        std::string deviceName = port->getDeviceId() >= 0 ? port->getDeviceName(port->getDeviceId()) : "(No device)";
+        menu->addChild(createSubmenuItem("Device", deviceName, [=](Menu* menu) {
+            menu->addChild(createCheckMenuItem("(No device)", "",
+                [=]() { return port->getDeviceId() < 0; },
+                [=]() { port->setDeviceId(-1); }
+            ));
+            for (int deviceId : port->getDeviceIds()) {
+                menu->addChild(createCheckMenuItem(port->getDeviceName(deviceId), "",
+                    [=]() { return port->getDeviceId() == deviceId; },
+                    [=]() { port->setDeviceId(deviceId); }
+                ));
+            }
+        }));
+    }
+
+#ifdef VIRTUAL_LCXL
+    // Script, rate, traffic stats and LED mirror of the software controller
+    static void appendVirtualControllerMenu(Menu* menu) {
+        VirtualLCXL* device = VirtualLCXL::get();
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createMenuLabel("Virtual Controller"));
+
+        static const char* scriptNames[VirtualLCXL::NUM_SCRIPTS] = {"Off", "Knob sweep", "Button presses", "MIDI storm"};
+        menu->addChild(createSubmenuItem("Script", scriptNames[device->getScript()], [=](Menu* menu) {
+            for (int s = 0; s < VirtualLCXL::NUM_SCRIPTS; s++) {
+                menu->addChild(createCheckMenuItem(scriptNames[s], "",
+                    [=]() { return device->getScript() == s; },
+                    [=]() { device->setScript(s); }
+                ));
+            }
+        }));
+
+        menu->addChild(createSubmenuItem("Rate", string::f("%d msgs/s", device->getRate()), [=](Menu* menu) {
+            static const int rates[] = {10, 100, 1000, 5000};
+            for (int rate : rates) {
+                menu->addChild(createCheckMenuItem(string::f("%d msgs/s", rate), "",
+                    [=]() { return device->getRate() == rate; },
+                    [=]() { device->setRate(rate); }
+                ));
+            }
+        }));
+
+        VirtualLCXL::Stats stats = device->getStats();
+        menu->addChild(createMenuLabel(string::f("From Core: %.0f msgs/s, %.0f bytes/s", stats.messagesPerSecond, stats.bytesPerSecond)));
+        menu->addChild(createMenuLabel(string::f("LED updates: %.0f/s", stats.ledUpdatesPerSecond)));
+        menu->addChild(createMenuLabel(string::f("To Core: %.0f msgs/s", stats.inputsPerSecond)));
+        menu->addChild(createMenuLabel(string::f("Input to LED: %.2f ms avg, %.2f ms max", stats.latencyAverage, stats.latencyMax)));
+        menu->addChild(createMenuItem("Reset stats", "", [=]() { device->resetStats(); }));
+
+        // LED mirror of the selected template: 3 knob rows, focus row, control row
+        int current = device->getTemplate();
+        std::string templateName = current >= LCXL::FACTORY_TEMPLATE_1
+            ? string::f("Factory %d", current - LCXL::FACTORY_TEMPLATE_1 + 1) : string::f("User %d", current + 1);
+        menu->addChild(createSubmenuItem("LEDs", templateName, [=](Menu* menu) {
+            int tmpl = device->getTemplate();
+            for (int row = 0; row < 5; row++) {
+                std::string text;
+                for (int col = 0; col < 8; col++) {
+                    uint8_t color = device->getLED(tmpl, row * 8 + col);
+                    bool red = color & 0x03;
+                    bool green = color & 0x30;
+                    text += red && green ? 'A' : red ? 'R' : green ? 'G' : '.';
+                    text += ' ';
+                }
+                menu->addChild(createMenuLabel(text));
+            }
+        }));
     }
+#endif
 };
 
 Model* modelCore = createModel<Core, CoreWidget>("Core");
@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+
+// Undo journal for edits made on the controller.
+// Only depends on the C++ standard library, like SequencerEngine.hpp.
+
+// What an EditRecord changed
+enum EditField {
+    EDIT_KNOB = 0,      // knobValues[layout][index] (value or parameter knob)
+    EDIT_GLIDE,         // Glide time of value position `index`
+    EDIT_STEP,          // Step `index` on/off
+    EDIT_COMP_MODE,
+    EDIT_ROUTE_MODE,
+    EDIT_VOLTAGE_A,
+    EDIT_VOLTAGE_B,
+    EDIT_BIPOLAR_A,
+    EDIT_BIPOLAR_B,
+    EDIT_CONDITION,     // Trig condition of step `index`
+    EDIT_PAGES,         // Step page count
+    EDIT_FILL,          // Fill on/off
+    EDIT_DENSITY        // Density generator knob (0-127)
+};
+
+// One edit: 8 bytes, so the whole journal stays small and flat
+struct EditRecord {
+    uint8_t field = EDIT_KNOB;
+    uint8_t layout = 0;     // 0 = default, 1-8 = sequencer
+    uint8_t index = 0;      // Knob/step index, if the field has one
+    uint8_t chained = 0;    // 1 = part of the same edit as the previous record (e.g. a utility)
+    int16_t oldValue = 0;
+    int16_t newValue = 0;
+};
+
+// Fixed-capacity ring buffer of edits with undo/redo. When full, the oldest
+// edits are overwritten. Nothing is allocated, so edits can be journaled from
+// the audio thread.
+struct EditJournal {
+    static constexpr int CAPACITY = 512;
+    EditRecord records[CAPACITY];
+    int head = 0;         // Where the next edit is written
+    int undoCount = 0;    // Records before head that can be undone
+    int redoCount = 0;    // Records from head on that can be redone
+    bool sealed = true;   // The next edit never merges into the previous one
+
+    // Add an edit. Drops any redo history. With `merge`, an edit of the same
+    // target as the previous record only updates its new value, so one knob turn
+    // is one undo step. Callers seal() the journal when a turn ends.
+    void push(const EditRecord& record, bool merge = false) {
+        if (merge && !sealed && undoCount > 0 && !record.chained) {
+            EditRecord& last = records[(head + CAPACITY - 1) % CAPACITY];
+            if (last.field == record.field && last.layout == record.layout && last.index == record.index && !last.chained) {
+                last.newValue = record.newValue;
+                redoCount = 0;
+                return;
+            }
+        }
+        records[head] = record;
+        head = (head + 1) % CAPACITY;
+        if (undoCount < CAPACITY) undoCount++;
+        redoCount = 0;
+        sealed = false;
+    }
+
+    // Undo the most recent edit (all of its chained records, newest first).
+    // apply(record, true) restores record.oldValue. Returns the number of records undone.
+    template <typename F>
+    int undo(F apply) {
+        int n = 0;
+        while (undoCount > 0) {
+            head = (head + CAPACITY - 1) % CAPACITY;
+            undoCount--;
+            redoCount++;
+            apply(records[head], true);
+            n++;
+            if (!records[head].chained) break;
+        }
+        sealed = true;
+        return n;
+    }
+
+    // Redo the next undone edit (all of its chained records, oldest first).
+    // apply(record, false) sets record.newValue. Returns the number of records redone.
+    template <typename F>
+    int redo(F apply) {
+        int n = 0;
+        while (redoCount > 0 && (n == 0 || records[head].chained)) {
+            apply(records[head], false);
+            head = (head + 1) % CAPACITY;
+            undoCount++;
+            redoCount--;
+            n++;
+        }
+        sealed = true;
+        return n;
+    }
+
+    // The next edit starts a new undo step, even on the same target
+    void seal() { sealed = true; }
+
+    // Drop the records of one layout (e.g. when its pattern was replaced), keeping
+    // the undo and redo history of the other layouts in order
+    void removeLayout(int layout) {
+        int start = (head + CAPACITY - undoCount) % CAPACITY;
+        int total = undoCount + redoCount;
+        int kept = 0;
+        int keptUndo = 0;
+        bool chainKept = false;
+        for (int i = 0; i < total; i++) {
+            EditRecord record = records[(start + i) % CAPACITY];
+            if (!record.chained) chainKept = false;
+            if (record.layout == layout) continue;
+            if (!chainKept) record.chained = 0;  // The start of its edit was dropped
+            chainKept = true;
+            records[(start + kept) % CAPACITY] = record;
+            kept++;
+            if (i < undoCount) keptUndo++;
+        }
+        head = (start + keptUndo) % CAPACITY;
+        undoCount = keptUndo;
+        redoCount = kept - keptUndo;
+        sealed = true;
+    }
+
+    void clear() {
+        head = 0;
+        undoCount = 0;
+        redoCount = 0;
+        sealed = true;
+    }
+};
@@ -1,12 +1,14 @@
 #pragma once
-#include <rack.hpp>
+#include "plugin.hpp"
+#include <atomic>
+#include <memory>
 
-// Message from ClockExpander (left of Core) to Core
+// Message from ClockExpander (left of Core) to Core.
+// Edge detection and chaining are resolved by the expander; Core only iterates the set bits.
 struct ClockExpanderMessage {
-    float clockA[8] = {0.f};  // Clock A voltages for each sequencer
-    float clockB[8] = {0.f};  // Clock B voltages for each sequencer
-    bool hasClockA[8] = {false};  // Whether clock A is connected (directly or via chain)
-    bool hasClockB[8] = {false};  // Whether clock B is connected
+    uint16_t risingEdges = 0;    // Bit s = clock A of sequencer s rose this frame, bit 8+s = clock B
+    uint8_t clockedSeqs = 0;     // Bit s = sequencer s is clocked by the expander (A connected directly or via chain)
+    float edgeOffsets[16] = {0.f};  // Sub-sample offset (0-1) of each rising edge before the expander's frame, same bit order
     int64_t moduleId = -1;
 };
 
@@ -29,7 +31,15 @@ enum ChangeType {
     CHANGE_COMP_MODE,
     CHANGE_ROUTE_MODE,
     CHANGE_STEP_TOGGLE,
-    CHANGE_UTILITY
+    CHANGE_UTILITY,
+    CHANGE_PATTERN,           // value = pattern 1-16, step = 1 if queued
+    CHANGE_PRESET,            // value = preset library record 1-256, step = 1 if empty
+    CHANGE_UNDO,              // value = edits left to undo (or redo), step = 1 for redo
+    CHANGE_STEP_CONDITION,    // value = StepCondition, step = step index
+    CHANGE_FILL,              // value = 1 if fill is on
+    CHANGE_EUCLID,            // value = hits, step = length
+    CHANGE_ROTATE,            // value = steps rotated (negative = earlier)
+    CHANGE_DENSITY            // value = density 0-100%
 };
 
 // Info about the most recent change
@@ -49,6 +59,20 @@ struct LCXLExpanderMessage {
     // Current layout (0 = default, 1-8 = sequencers)
     int currentLayout = 0;
 
+    // Core's control-rate division: expanders update lights/displays every N frames
+    int controlRateDivision = 32;
+
+    // Layout morph: when active, knob outputs follow morphKnobs (0-127) instead
+    // of the current layout
+    bool morphActive = false;
+    float morphKnobs[24] = {0.f};
+
+    // Incremented whenever knobValues / morphKnobs change, so expanders only
+    // recompute knob outputs when these move
+    uint32_t knobRevision = 0;
+    uint32_t morphRevision = 0;
+    uint32_t cvRevision = 0;      // Incremented whenever a sequencer's CV 1-3 or Seq A voltage setting changes
+
     // Fader values
     int faderValues[8] = {0};
 
@@ -58,9 +82,16 @@ struct LCXLExpanderMessage {
     // Button momentary mode (true = momentary, false = toggle)
     bool buttonMomentary[16] = {false};
 
+    uint32_t buttonRevision = 0;      // Incremented whenever buttonStates change
+    uint32_t buttonPresses[16] = {0};  // Presses so far per button; expanders fire when it changes
+
     // Sequencer data for all 8 sequencers
     struct SequencerData {
-        bool steps[16] = {false};
+        // Steps of the page shown on the buttons, bit i = button i. Long patterns
+        // only send this page; the playheads below are absolute steps.
+        uint16_t steps = 0;
+        uint8_t page = 0;                // Shown page (always 0 in dual step mode)
+        uint8_t pages = 1;               // Pages in use
 
         // Sequence A (uses steps 0-7 in dual, 0-15 in single)
         int currentStepA = 0;
@@ -68,6 +99,9 @@ struct LCXLExpanderMessage {
         int stepLengthA = 8;
         int valueLengthA = 8;
         bool triggeredA = false;
+        float triggerOffsetA = 0.f;  // Sub-sample clock edge position (0-1 samples before Core's frame)
+        float triggerLengthA = 1e-3f; // Pulse/gate length in seconds
+        uint32_t triggerCountA = 0;   // Triggers so far; expanders fire when it changes
 
         // Sequence B (uses steps 8-15, only in dual mode)
         int currentStepB = 0;
@@ -75,6 +109,9 @@ struct LCXLExpanderMessage {
         int stepLengthB = 4;
         int valueLengthB = 4;
         bool triggeredB = false;
+        float triggerOffsetB = 0.f;  // Sub-sample clock edge position (0-1 samples before Core's frame)
+        float triggerLengthB = 1e-3f; // Pulse/gate length in seconds
+        uint32_t triggerCountB = 0;
 
         // Mode flags
         bool isValueSingleMode = false;  // true = all 16 values for A
@@ -112,3 +149,82 @@ struct LCXLExpanderMessage {
     // Module ID for validation
     int64_t moduleId = -1;
 };
+
+// Core's state as seen by the expander chain. Core owns one snapshot and every
+// expander reads it through a shared pointer instead of copying it along the chain.
+//
+// Double-buffered: Core fills the buffer that isn't readable, then increments
+// `generation`, whose low bit selects the readable buffer. Rack finishes every
+// module's process() before starting the next frame, so a buffer is never
+// rewritten while an expander is still reading it. Depending on module order an
+// expander can see a generation twice or skip one, which is why triggers are
+// carried as counters rather than per-frame flags.
+struct LCXLSnapshot {
+    LCXLExpanderMessage buffers[2];
+    std::atomic<uint32_t> generation{0};
+
+    LCXLExpanderMessage& beginWrite() {
+        return buffers[(generation.load(std::memory_order_relaxed) + 1) & 1];
+    }
+    void publish() {
+        generation.fetch_add(1, std::memory_order_release);
+    }
+};
+
+// Modules that receive the snapshot from their left neighbour
+inline bool isChainExpander(Module* m) {
+    return m && (m->model == modelKnobExpander || m->model == modelGateExpander ||
+                 m->model == modelSeqExpander || m->model == modelCVExpander ||
+                 m->model == modelStepDisplay || m->model == modelInfoDisplay);
+}
+
+// Hand the snapshot to the module on the right. The expander message (a shared
+// pointer) is only written when it changes, so steady-state frames don't touch
+// reference counts.
+inline void sendSnapshot(Module* right, const std::shared_ptr<LCXLSnapshot>& snapshot) {
+    if (!isChainExpander(right)) return;
+    std::shared_ptr<LCXLSnapshot>* msg = static_cast<std::shared_ptr<LCXLSnapshot>*>(right->leftExpander.producerMessage);
+    if (msg && *msg != snapshot) {
+        *msg = snapshot;
+        right->leftExpander.messageFlipRequested = true;
+    }
+}
+
+// An expander's place in the chain: the snapshot received from the left and the
+// generation it last read
+struct LCXLChainLink {
+    std::shared_ptr<LCXLSnapshot> leftMessages[2];
+    std::shared_ptr<LCXLSnapshot> snapshot;
+    uint32_t generation = 0;
+
+    void attach(Module* module) {
+        module->leftExpander.producerMessage = &leftMessages[0];
+        module->leftExpander.consumerMessage = &leftMessages[1];
+    }
+
+    // Take the snapshot from the left neighbour, if it is part of the chain.
+    // Returns Core's latest state, or nullptr if not connected to a Core.
+    // `fresh` is set if Core published since the last call.
+    const LCXLExpanderMessage* receive(Module* module, bool leftInChain, bool* fresh) {
+        std::shared_ptr<LCXLSnapshot>* incoming = leftInChain
+            ? static_cast<std::shared_ptr<LCXLSnapshot>*>(module->leftExpander.consumerMessage) : nullptr;
+        *fresh = false;
+        if (!incoming || !*incoming) {
+            if (snapshot) snapshot.reset();
+            return nullptr;
+        }
+        if (snapshot != *incoming) {
+            snapshot = *incoming;
+            *fresh = true;
+        }
+        uint32_t gen = snapshot->generation.load(std::memory_order_acquire);
+        if (gen != generation) *fresh = true;
+        generation = gen;
+        return &snapshot->buffers[gen & 1];
+    }
+
+    // Pass the snapshot (or the lack of one) on to the right
+    void forward(Module* right) {
+        sendSnapshot(right, snapshot);
+    }
+};
@@ -1,5 +1,6 @@
 #include "plugin.hpp"
 #include "ExpanderMessage.hpp"
+#include <cstring>  // for memcpy
 
 struct GateExpander : Module {
     enum ParamId {
@@ -10,6 +11,8 @@ struct GateExpander : Module {
     };
     enum OutputId {
         ENUMS(GATE_OUTPUT, 16),
+        POLY_GATE_OUTPUT,  // All 16 gates, one per channel
+        POLY_TRIG_OUTPUT,  // A trigger per button press, one channel per button
         OUTPUTS_LEN
     };
     enum LightId {
@@ -17,11 +20,22 @@ struct GateExpander : Module {
         LIGHTS_LEN
     };
 
-    LCXLExpanderMessage leftMessages[2];
-    LCXLExpanderMessage expanderMessage;  // For forwarding to right
+    LCXLChainLink link;  // Core's shared snapshot, received from the left and passed on
+    dsp::ClockDivider controlDivider;  // Control-rate scheduler, division follows Core
+
+    // Gates only change on button events, so they are rewritten only when Core's
+    // button revision moves
+    bool gatesValid = false;
+    uint32_t shownButtonRevision = 0;
+
+    dsp::PulseGenerator pressPulses[16];
+    uint16_t pulsing = 0;                 // Bit per press trigger that is high
+    uint32_t buttonPresses[16] = {0};     // Core's press counters as of the last fired trigger
+    const LCXLSnapshot* countedSnapshot = nullptr;  // Snapshot the counters belong to
 
     GateExpander() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+        controlDivider.setDivision(32);
 
         // Configure gate outputs
         for (int i = 0; i < 8; i++) {
@@ -30,10 +44,11 @@ struct GateExpander : Module {
         for (int i = 0; i < 8; i++) {
             configOutput(GATE_OUTPUT + 8 + i, string::f("Gate %d (Control)", i + 1));
         }
+        configOutput(POLY_GATE_OUTPUT, "Polyphonic gates (Focus 1-8, Control 1-8)");
+        configOutput(POLY_TRIG_OUTPUT, "Polyphonic press triggers (Focus 1-8, Control 1-8)");
 
         // Setup expander message buffers
-        leftExpander.producerMessage = &leftMessages[0];
-        leftExpander.consumerMessage = &leftMessages[1];
+        link.attach(this);
     }
 
     bool isValidExpander(Module* m) {
@@ -44,42 +59,72 @@ struct GateExpander : Module {
     }
 
     void process(const ProcessArgs& args) override {
-        bool connected = false;
-        LCXLExpanderMessage* msg = nullptr;
+        bool controlTick = controlDivider.process();  // Lights/display run at Core's control rate
 
-        // Check if connected to Core or another expander on the left
-        if (isValidExpander(leftExpander.module)) {
-            msg = reinterpret_cast<LCXLExpanderMessage*>(leftExpander.consumerMessage);
-            if (msg && msg->moduleId >= 0) {
-                connected = true;
+        // Get Core's snapshot from the left neighbour and pass it on to the right
+        bool fresh = false;  // Core published since the last frame
+        const LCXLExpanderMessage* msg = link.receive(this, isValidExpander(leftExpander.module), &fresh);
+        bool connected = msg != nullptr;
+        link.forward(rightExpander.module);
 
-                // Output button states as gates (10V when on, 0V when off)
-                for (int i = 0; i < 16; i++) {
-                    outputs[GATE_OUTPUT + i].setVoltage(msg->buttonStates[i] ? 10.f : 0.f);
-                }
+        if (connected) {
+            controlDivider.setDivision(msg->controlRateDivision);
 
-                // Store for forwarding
-                expanderMessage = *msg;
+            // Output button states as gates (10V when on, 0V when off), when they changed
+            if (!gatesValid || msg->buttonRevision != shownButtonRevision) {
+                updateGates(msg);
             }
-        }
 
-        // Forward message to right expander
-        if (rightExpander.module && connected) {
-            LCXLExpanderMessage* rightMsg = reinterpret_cast<LCXLExpanderMessage*>(rightExpander.module->leftExpander.producerMessage);
-            if (rightMsg) {
-                *rightMsg = expanderMessage;
-                rightExpander.module->leftExpander.messageFlipRequested = true;
+            // A new Core: take over its counters without firing
+            if (countedSnapshot != link.snapshot.get()) {
+                countedSnapshot = link.snapshot.get();
+                std::memcpy(buttonPresses, msg->buttonPresses, sizeof(buttonPresses));
             }
-        }
 
-        // If not connected, output zeros
-        if (!connected) {
+            // Fire a trigger for each press since the last frame Core published
+            if (fresh) {
+                for (int i = 0; i < 16; i++) {
+                    if (msg->buttonPresses[i] == buttonPresses[i]) continue;
+                    buttonPresses[i] = msg->buttonPresses[i];
+                    pressPulses[i].trigger(1e-3f);
+                    pulsing |= 1 << i;
+                }
+            }
+        } else if (gatesValid) {
+            // If not connected, output zeros
             for (int i = 0; i < 16; i++) {
                 outputs[GATE_OUTPUT + i].setVoltage(0.f);
+                outputs[POLY_GATE_OUTPUT].setVoltage(0.f, i);
             }
+            gatesValid = false;
+            countedSnapshot = nullptr;
+        }
+
+        // Only triggers that are high need processing
+        for (int i = 0; pulsing >> i; i++) {
+            if (!(pulsing & (1 << i))) continue;
+            bool high = pressPulses[i].process(args.sampleTime);
+            outputs[POLY_TRIG_OUTPUT].setVoltage(high ? 10.f : 0.f, i);
+            if (!high) pulsing &= ~(1 << i);
+        }
+
+        if (controlTick) {
+            lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
         }
+    }
 
-        lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+    void updateGates(const LCXLExpanderMessage* msg) {
+        shownButtonRevision = msg->buttonRevision;
+        gatesValid = true;
+
+        Output& poly = outputs[POLY_GATE_OUTPUT];
+        poly.setChannels(16);
+        outputs[POLY_TRIG_OUTPUT].setChannels(16);
+        for (int i = 0; i < 16; i++) {
+            float voltage = msg->buttonStates[i] ? 10.f : 0.f;
+            outputs[GATE_OUTPUT + i].setVoltage(voltage);
+            poly.setVoltage(voltage, i);
+        }
     }
 };
 
@@ -135,6 +180,12 @@ struct GateExpanderWidget : ModuleWidget {
         addLabel(mm2px(Vec(0, 14)), mm2px(Vec(15, 4)), "FOCUS");
         addLabel(mm2px(Vec(10, 14)), mm2px(Vec(15, 4)), "CTRL");
 
+        // Polyphonic gates and press triggers (16 channels each)
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(7.5, 103)), module, GateExpander::POLY_GATE_OUTPUT));
+        addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(17.5, 103)), module, GateExpander::POLY_TRIG_OUTPUT));
+        addLabel(mm2px(Vec(0, 96.5)), mm2px(Vec(15, 3)), "GATES", 5.f);
+        addLabel(mm2px(Vec(10, 96.5)), mm2px(Vec(15, 3)), "TRIGS", 5.f);
+
         // Row numbers (on the right side)
         for (int i = 0; i < 8; i++) {
             addLabel(mm2px(Vec(21, 20 + i * 10)), mm2px(Vec(5, 4)), std::to_string(i + 1), 6.f);
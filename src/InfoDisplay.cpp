@@ -16,8 +16,8 @@ struct InfoDisplay : Module {
         LIGHTS_LEN
     };
 
-    LCXLExpanderMessage leftMessages[2];
-    LCXLExpanderMessage expanderMessage;  // For forwarding to right
+    LCXLChainLink link;  // Core's shared snapshot, received from the left and passed on
+    dsp::ClockDivider controlDivider;  // Control-rate scheduler, division follows Core
 
     // Display text
     std::string line1 = "";
@@ -26,10 +26,10 @@ struct InfoDisplay : Module {
 
     InfoDisplay() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+        controlDivider.setDivision(32);
 
         // Setup expander message buffers
-        leftExpander.producerMessage = &leftMessages[0];
-        leftExpander.consumerMessage = &leftMessages[1];
+        link.attach(this);
     }
 
     bool isValidExpander(Module* m) {
@@ -63,6 +63,14 @@ struct InfoDisplay : Module {
             case CHANGE_ROUTE_MODE: return "Route Mode";
             case CHANGE_STEP_TOGGLE: return "Step";
             case CHANGE_UTILITY: return "Utility";
+            case CHANGE_PATTERN: return "Pattern";
+            case CHANGE_PRESET: return "Preset";
+            case CHANGE_UNDO: return "Edit";
+            case CHANGE_STEP_CONDITION: return "Condition";
+            case CHANGE_FILL: return "Fill";
+            case CHANGE_EUCLID: return "Euclid";
+            case CHANGE_ROTATE: return "Rotate";
+            case CHANGE_DENSITY: return "Density";
             default: return "";
         }
     }
@@ -111,60 +119,69 @@ struct InfoDisplay : Module {
                 }
             case CHANGE_STEP_TOGGLE:
                 return "Step " + std::to_string(step + 1) + " " + (value ? "On" : "Off");
+            case CHANGE_PATTERN:
+                return "P" + std::to_string(value) + (step ? " queued" : "");
+            case CHANGE_PRESET:
+                return "#" + std::to_string(value) + (step ? " empty" : "");
+            case CHANGE_UNDO:
+                return (step ? "Redo (" : "Undo (") + std::to_string(value) + ")";
+            case CHANGE_STEP_CONDITION: {
+                static const char* const names[] = {"Always", "75%", "50%", "25%", "1:2", "2:2", "1:4", "3:4", "Fill", "Not Fill"};
+                return "Step " + std::to_string(step + 1) + " " + (value >= 0 && value < 10 ? names[value] : "?");
+            }
+            case CHANGE_FILL:
+                return value ? "On" : "Off";
+            case CHANGE_EUCLID:
+                return std::to_string(value) + " of " + std::to_string(step);
+            case CHANGE_ROTATE:
+                return (value > 0 ? "+" : "") + std::to_string(value);
+            case CHANGE_DENSITY:
+                return std::to_string(value) + "%";
             default:
                 return std::to_string(value);
         }
     }
 
     void process(const ProcessArgs& args) override {
-        bool connected = false;
-        LCXLExpanderMessage* msg = nullptr;
-
-        // Check if connected to Core or another expander on the left
-        if (isValidExpander(leftExpander.module)) {
-            msg = reinterpret_cast<LCXLExpanderMessage*>(leftExpander.consumerMessage);
-            if (msg && msg->moduleId >= 0) {
-                connected = true;
-
-                // Update display text based on last change
-                auto& change = msg->lastChange;
-                if (change.type != CHANGE_NONE) {
-                    // Line 1: Sequencer/Layout info
-                    if (change.sequencer == 0) {
-                        line1 = "Default";
-                    } else {
-                        line1 = "Seq " + std::to_string(change.sequencer);
-                    }
-
-                    // Line 2: Parameter name
-                    line2 = getChangeTypeName(change.type);
-
-                    // Line 3: Value
-                    line3 = getValueString(change.type, change.value, change.step);
+        bool controlTick = controlDivider.process();  // Lights/display run at Core's control rate
+
+        // Get Core's snapshot from the left neighbour and pass it on to the right
+        bool fresh = false;  // Core published since the last frame
+        const LCXLExpanderMessage* msg = link.receive(this, isValidExpander(leftExpander.module), &fresh);
+        bool connected = msg != nullptr;
+        link.forward(rightExpander.module);
+
+        if (connected) {
+            controlDivider.setDivision(msg->controlRateDivision);
+
+            // Update display text based on last change (control rate)
+            auto& change = msg->lastChange;
+            if (controlTick && change.type != CHANGE_NONE) {
+                // Line 1: Sequencer/Layout info
+                if (change.sequencer == 0) {
+                    line1 = "Default";
+                } else {
+                    line1 = "Seq " + std::to_string(change.sequencer);
                 }
 
-                // Store for forwarding
-                expanderMessage = *msg;
-            }
-        }
+                // Line 2: Parameter name
+                line2 = getChangeTypeName(change.type);
 
-        // Forward message to right expander
-        if (rightExpander.module && connected) {
-            LCXLExpanderMessage* rightMsg = reinterpret_cast<LCXLExpanderMessage*>(rightExpander.module->leftExpander.producerMessage);
-            if (rightMsg) {
-                *rightMsg = expanderMessage;
-                rightExpander.module->leftExpander.messageFlipRequested = true;
+                // Line 3: Value
+                line3 = getValueString(change.type, change.value, change.step);
             }
         }
 
         // If not connected, clear display
-        if (!connected) {
+        if (!connected && controlTick) {
             line1 = "";
             line2 = "";
             line3 = "";
         }
 
-        lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        if (controlTick) {
+            lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        }
     }
 };
 
@@ -17,11 +17,23 @@ struct KnobExpander : Module {
         LIGHTS_LEN
     };
 
-    LCXLExpanderMessage leftMessages[2];
-    LCXLExpanderMessage expanderMessage;  // For forwarding to right
+    LCXLChainLink link;  // Core's shared snapshot, received from the left and passed on
+    dsp::ClockDivider controlDivider;  // Control-rate scheduler, division follows Core
+
+    int pinnedLayout = -1;     // Layout to output (0 = default, 1-8 = sequencers, -1 = follow Core's view)
+    bool polyphonic = false;   // Jack 1 of each row also carries the whole row as 8 channels
+
+    // What the outputs were last computed from; knobs move rarely compared to the
+    // sample rate, so outputs are only rewritten when one of these changes
+    bool outputsValid = false;
+    int shownLayout = 0;
+    bool shownMorph = false;
+    uint32_t shownKnobRevision = 0;
+    uint32_t shownMorphRevision = 0;
 
     KnobExpander() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+        controlDivider.setDivision(32);
 
         // Configure knob outputs
         for (int i = 0; i < 8; i++) {
@@ -35,8 +47,7 @@ struct KnobExpander : Module {
         }
 
         // Setup expander message buffers
-        leftExpander.producerMessage = &leftMessages[0];
-        leftExpander.consumerMessage = &leftMessages[1];
+        link.attach(this);
     }
 
     bool isValidExpander(Module* m) {
@@ -47,44 +58,95 @@ struct KnobExpander : Module {
     }
 
     void process(const ProcessArgs& args) override {
-        bool connected = false;
-        LCXLExpanderMessage* msg = nullptr;
-
-        // Check if connected to Core or another expander on the left
-        if (isValidExpander(leftExpander.module)) {
-            msg = reinterpret_cast<LCXLExpanderMessage*>(leftExpander.consumerMessage);
-            if (msg && msg->moduleId >= 0) {
-                connected = true;
-                int layout = msg->currentLayout;
-
-                // Output knob values for current layout (0-10V)
-                for (int i = 0; i < 24; i++) {
-                    float voltage = msg->knobValues[layout][i] / 127.f * 10.f;
-                    outputs[KNOB_OUTPUT + i].setVoltage(voltage);
+        bool controlTick = controlDivider.process();  // Lights/display run at Core's control rate
+
+        // Get Core's snapshot from the left neighbour and pass it on to the right
+        bool fresh = false;  // Core published since the last frame
+        const LCXLExpanderMessage* msg = link.receive(this, isValidExpander(leftExpander.module), &fresh);
+        bool connected = msg != nullptr;
+        link.forward(rightExpander.module);
+
+        if (connected) {
+            controlDivider.setDivision(msg->controlRateDivision);
+
+            // Output knob values for the pinned or current layout, or the morph if
+            // active and following Core (0-10V). Outputs hold their voltage until
+            // the knobs they show change.
+            if (fresh || !outputsValid) {
+                int layout = pinnedLayout >= 0 ? pinnedLayout : msg->currentLayout;
+                bool morph = pinnedLayout < 0 && msg->morphActive;
+                if (!outputsValid || layout != shownLayout || morph != shownMorph
+                    || (morph ? msg->morphRevision != shownMorphRevision : msg->knobRevision != shownKnobRevision)) {
+                    updateOutputs(msg, layout, morph);
                 }
-
-                // Store for forwarding
-                expanderMessage = *msg;
             }
+        } else if (outputsValid) {
+            // If not connected, output zeros
+            for (int i = 0; i < 24; i++) {
+                outputs[KNOB_OUTPUT + i].setVoltage(0.f);
+            }
+            for (int row = 0; row < 3; row++) {
+                outputs[KNOB_OUTPUT + row * 8].setChannels(1);
+            }
+            outputsValid = false;
         }
 
-        // Forward message to right expander
-        if (rightExpander.module && connected) {
-            LCXLExpanderMessage* rightMsg = reinterpret_cast<LCXLExpanderMessage*>(rightExpander.module->leftExpander.producerMessage);
-            if (rightMsg) {
-                *rightMsg = expanderMessage;
-                rightExpander.module->leftExpander.messageFlipRequested = true;
-            }
+        if (controlTick) {
+            lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
         }
+    }
 
-        // If not connected, output zeros
-        if (!connected) {
-            for (int i = 0; i < 24; i++) {
-                outputs[KNOB_OUTPUT + i].setVoltage(0.f);
+    // Convert the shown knobs to volts, 4 at a time
+    void updateOutputs(const LCXLExpanderMessage* msg, int layout, bool morph) {
+        shownLayout = layout;
+        shownMorph = morph;
+        shownKnobRevision = msg->knobRevision;
+        shownMorphRevision = msg->morphRevision;
+        outputsValid = true;
+
+        alignas(16) float volts[24];
+        for (int i = 0; i < 24; i += 4) {
+            simd::float_4 value = morph ? simd::float_4::load(&msg->morphKnobs[i])
+                                        : simd::float_4(simd::int32_4::load(&msg->knobValues[layout][i]));
+            (value * (10.f / 127.f)).store(&volts[i]);
+        }
+
+        for (int i = 0; i < 24; i++) {
+            outputs[KNOB_OUTPUT + i].setVoltage(volts[i]);
+        }
+        for (int row = 0; row < 3; row++) {
+            Output& output = outputs[KNOB_OUTPUT + row * 8];
+            output.setChannels(polyphonic ? 8 : 1);
+            if (polyphonic) {
+                output.setVoltageSimd(simd::float_4::load(&volts[row * 8]), 0);
+                output.setVoltageSimd(simd::float_4::load(&volts[row * 8 + 4]), 4);
             }
         }
+    }
+
+    // Options are changed from the UI thread; outputs are recomputed on the next frame
+    void setPolyphonic(bool poly) {
+        polyphonic = poly;
+        outputsValid = false;
+    }
+
+    void setPinnedLayout(int layout) {
+        pinnedLayout = layout;
+        outputsValid = false;
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "pinnedLayout", json_integer(pinnedLayout));
+        json_object_set_new(rootJ, "polyphonic", json_boolean(polyphonic));
+        return rootJ;
+    }
 
-        lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+    void dataFromJson(json_t* rootJ) override {
+        json_t* pinnedJ = json_object_get(rootJ, "pinnedLayout");
+        if (pinnedJ) setPinnedLayout(clamp((int) json_integer_value(pinnedJ), -1, 8));
+        json_t* polyJ = json_object_get(rootJ, "polyphonic");
+        if (polyJ) setPolyphonic(json_boolean_value(polyJ));
     }
 };
 
@@ -156,6 +218,29 @@ struct KnobExpanderWidget : ModuleWidget {
         // Brand below line
         addLabel(mm2px(Vec(10, 120)), mm2px(Vec(15, 8)), "LCXL", 14.f);
     }
+
+    void appendContextMenu(Menu* menu) override {
+        KnobExpander* module = dynamic_cast<KnobExpander*>(this->module);
+        if (!module) return;
+
+        auto layoutName = [](int layout) {
+            return layout < 0 ? std::string("Follow Core") : layout == 0 ? std::string("Default") : string::f("Sequencer %d", layout);
+        };
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createSubmenuItem("Layout", layoutName(module->pinnedLayout), [=](Menu* menu) {
+            for (int l = -1; l <= 8; l++) {
+                menu->addChild(createCheckMenuItem(layoutName(l), "",
+                    [=]() { return module->pinnedLayout == l; },
+                    [=]() { module->setPinnedLayout(l); }
+                ));
+            }
+        }));
+        menu->addChild(createCheckMenuItem("Polyphonic rows (jack 1, 8 channels)", "",
+            [=]() { return module->polyphonic; },
+            [=]() { module->setPolyphonic(!module->polyphonic); }
+        ));
+    }
 };
 
 Model* modelKnobExpander = createModel<KnobExpander, KnobExpanderWidget>("KnobExpander");
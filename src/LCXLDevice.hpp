@@ -0,0 +1,109 @@
+#pragma once
+#include <rack.hpp>
+#include <midi.hpp>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+using namespace rack;
+
+// Shared state for one physical Launch Control XL, used by every Core module that
+// drives it (one Core per factory template).
+//
+// Incoming MIDI is demultiplexed by Rack's MIDI driver: each Core sets its input
+// port's channel to its template, so the driver only queues messages addressed to
+// that Core and no Core parses another template's traffic.
+//
+// Outgoing LED changes are collected by each Core in its own LEDQueue, without
+// locking, and sent as one SysEx per frame (multiple index/color pairs per
+// message) instead of a stream of single-LED messages.
+//
+// The device mirrors what the hardware currently shows: the color last sent to each
+// LED and the template last selected. Colors the hardware already shows are not
+// sent again, and after a reconnect or template change a Core can repaint its
+// template without blanking it first (see Core::beginResync).
+struct LCXLDevice {
+    static constexpr int NUM_TEMPLATES = 16;
+    static constexpr int NUM_LEDS = 48;  // 0-23 knobs, 24-39 channel buttons, 40-47 side buttons
+    static constexpr uint8_t UNKNOWN = 0xFF;  // Mirror entry for an LED in an unknown state
+
+    // LED colors one Core queued for its template. Only ever touched by that
+    // Core's audio thread, so queueing takes no lock.
+    struct LEDQueue {
+        uint8_t pending[NUM_LEDS];  // Queued color per LED (valid where dirty is set)
+        uint64_t dirty = 0;         // Bit per LED with a queued color
+
+        // Queue an LED color; a later color for the same LED replaces the earlier one
+        void queue(int index, uint8_t color) {
+            pending[index] = color;
+            dirty |= 1ull << index;
+        }
+
+        void clear() { dirty = 0; }
+    };
+
+    std::mutex mutex;                          // Guards shown (held briefly, never while sending)
+    uint8_t shown[NUM_TEMPLATES][NUM_LEDS];    // Color the hardware shows, UNKNOWN if not known
+    std::atomic<int> selectedTemplate{-1};     // Template selected on the hardware, -1 if not known
+
+    LCXLDevice() {
+        std::memset(shown, UNKNOWN, sizeof(shown));
+    }
+
+    // Forget what a template shows (the hardware was reconnected or may have
+    // changed it), so the next color queued for each of its LEDs is sent
+    void forget(int tmpl) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::memset(shown[tmpl], UNKNOWN, sizeof(shown[tmpl]));
+    }
+
+    // Send a Core's queued LEDs for template `tmpl` through its output. The queue
+    // is merged into the mirror under a try_lock: if another thread holds the
+    // mirror, the LEDs stay queued for the next frame instead of waiting. The
+    // SysEx is built and sent after the lock is released.
+    void flush(LEDQueue& queue, int tmpl, midi::Output& output) {
+        uint8_t changes[2 * NUM_LEDS];  // Index/color pairs the hardware doesn't show yet
+        int size = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+            if (!lock.owns_lock()) return;
+            uint64_t dirty = queue.dirty;
+            for (int i = 0; dirty; i++, dirty >>= 1) {
+                if (!(dirty & 1)) continue;
+                uint8_t color = queue.pending[i];
+                if (color == shown[tmpl][i]) continue;  // Already showing
+                shown[tmpl][i] = color;
+                changes[size++] = static_cast<uint8_t>(i);
+                changes[size++] = color;
+            }
+            queue.dirty = 0;
+        }
+        if (size == 0) return;  // Everything queued was already shown
+
+        // SysEx: F0 00 20 29 02 11 78 [template] ([index] [color])... F7
+        midi::Message msg;
+        msg.bytes = {0xF0, 0x00, 0x20, 0x29, 0x02, 0x11, 0x78, static_cast<uint8_t>(tmpl)};
+        msg.bytes.insert(msg.bytes.end(), changes, changes + size);
+        msg.bytes.push_back(0xF7);
+        output.sendMessage(msg);
+    }
+
+    // Get the shared state for a MIDI output device, creating it for the first Core.
+    // The state is released when the last Core using it lets go of it.
+    static std::shared_ptr<LCXLDevice> acquire(int driverId, int deviceId) {
+        static std::mutex registryMutex;
+        static std::map<std::pair<int, int>, std::weak_ptr<LCXLDevice>> registry;
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        std::weak_ptr<LCXLDevice>& entry = registry[std::make_pair(driverId, deviceId)];
+        std::shared_ptr<LCXLDevice> device = entry.lock();
+        if (!device) {
+            device = std::make_shared<LCXLDevice>();
+            entry = device;
+        }
+        return device;
+    }
+};
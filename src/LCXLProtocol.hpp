@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+
+// Launch Control XL Factory Template 1 MIDI mappings (Channel 9)
+namespace LCXL {
+    // CC numbers for knobs (3 rows of 8)
+    constexpr int KNOB_ROW1[] = {13, 14, 15, 16, 17, 18, 19, 20};  // Send A
+    constexpr int KNOB_ROW2[] = {29, 30, 31, 32, 33, 34, 35, 36};  // Send B
+    constexpr int KNOB_ROW3[] = {49, 50, 51, 52, 53, 54, 55, 56};  // Pan/Device
+
+    // CC numbers for faders
+    constexpr int FADERS[] = {77, 78, 79, 80, 81, 82, 83, 84};
+
+    // Note numbers for buttons
+    constexpr int TRACK_FOCUS[] = {41, 42, 43, 44, 57, 58, 59, 60};
+    constexpr int TRACK_CONTROL[] = {73, 74, 75, 76, 89, 90, 91, 92};
+
+    // CC numbers for navigation buttons
+    constexpr int BTN_UP = 104;
+    constexpr int BTN_DOWN = 105;
+    constexpr int BTN_LEFT = 106;
+    constexpr int BTN_RIGHT = 107;
+
+    // Button indices for Device, Mute, Solo, Record Arm
+    constexpr int BTN_DEVICE = 105;  // Note number
+    constexpr int BTN_MUTE = 106;
+    constexpr int BTN_SOLO = 107;
+    constexpr int BTN_REC_ARM = 108;
+
+    // LED color values (bits 0-1: red 0-3, bits 4-5: green 0-3, base 12)
+    constexpr uint8_t LED_OFF = 12;
+    constexpr uint8_t LED_RED_LOW = 13;
+    constexpr uint8_t LED_RED_FULL = 15;
+    constexpr uint8_t LED_GREEN_LOW = 28;
+    constexpr uint8_t LED_GREEN_MID = 44;
+    constexpr uint8_t LED_GREEN_FULL = 60;
+    constexpr uint8_t LED_AMBER_LOW = 29;
+    constexpr uint8_t LED_AMBER_FULL = 63;
+    constexpr uint8_t LED_YELLOW_LOW = 30;
+    constexpr uint8_t LED_YELLOW_FULL = 62;
+
+    // SysEx header for Launch Control XL
+    constexpr uint8_t SYSEX_HEADER[] = {0x00, 0x20, 0x29, 0x02, 0x11};
+
+    // Step button colors, indexed by (isPlayhead << 1) | isActive
+    constexpr uint8_t STEP_PALETTE[4] = {
+        LED_OFF,         // Inactive step
+        LED_GREEN_LOW,   // Active step: dim green
+        LED_RED_LOW,     // Playhead on inactive step: dim red
+        LED_GREEN_FULL   // Playhead on active step: bright green
+    };
+
+    // Trig condition colors, indexed by StepCondition (see SequencerEngine.hpp)
+    constexpr uint8_t CONDITION_PALETTE[10] = {
+        LED_OFF,          // Always
+        LED_GREEN_FULL,   // 75%
+        LED_GREEN_MID,    // 50%
+        LED_GREEN_LOW,    // 25%
+        LED_AMBER_FULL,   // 1:2
+        LED_AMBER_LOW,    // 2:2
+        LED_YELLOW_FULL,  // 1:4
+        LED_YELLOW_LOW,   // 3:4
+        LED_RED_FULL,     // Fill
+        LED_RED_LOW       // Not fill
+    };
+
+    // Soft takeover knob colors, indexed by [PickupState][bright]
+    enum PickupState {
+        PICKUP_OK,          // Picked up (or within range)
+        PICKUP_TURN_RIGHT,  // Physical knob below stored value
+        PICKUP_TURN_LEFT    // Physical knob above stored value
+    };
+    constexpr uint8_t TAKEOVER_PALETTE[3][2] = {
+        {LED_GREEN_LOW, LED_GREEN_FULL},
+        {LED_YELLOW_LOW, LED_YELLOW_FULL},
+        {LED_RED_LOW, LED_RED_FULL}
+    };
+
+    // Factory templates 1-8 are templates 8-15 and use MIDI channels 9-16 (index 8-15).
+    // All factory templates share the mappings above, so each Core can use its own.
+    constexpr int FACTORY_TEMPLATE_1 = 8;
+    constexpr int NUM_FACTORY_TEMPLATES = 8;
+}
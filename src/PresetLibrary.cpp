@@ -0,0 +1,148 @@
+#include "plugin.hpp"
+#include "PresetLibrary.hpp"
+#include <cstring>
+
+#if defined ARCH_WIN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+std::atomic<uint32_t> PresetLibrary::writeCount{0};
+
+bool PresetLibrary::open(const std::string& path) {
+    close();
+    size_t size = sizeof(Header) + CAPACITY * sizeof(PresetRecord);
+    bool created = false;
+
+#if defined ARCH_WIN
+    HANDLE file = CreateFileW(string::UTF8toUTF16(path).c_str(), GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        WARN("Could not open preset library %s", path.c_str());
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart != 0 && (size_t) fileSize.QuadPart != size)) {
+        WARN("Preset library %s has an unexpected size, ignoring it", path.c_str());
+        CloseHandle(file);
+        return false;
+    }
+    created = fileSize.QuadPart == 0;
+
+    // Mapping past the end grows a new (empty) file to full size
+    HANDLE map = CreateFileMappingW(file, NULL, PAGE_READWRITE, 0, (DWORD) size, NULL);
+    void* view = map ? MapViewOfFile(map, FILE_MAP_ALL_ACCESS, 0, 0, size) : NULL;
+    if (!view) {
+        WARN("Could not map preset library %s", path.c_str());
+        if (map) CloseHandle(map);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = map;
+    mapping = view;
+#else
+    int file = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (file < 0) {
+        WARN("Could not open preset library %s", path.c_str());
+        return false;
+    }
+    struct stat st;
+    if (fstat(file, &st) != 0 || (st.st_size != 0 && (size_t) st.st_size != size)) {
+        WARN("Preset library %s has an unexpected size, ignoring it", path.c_str());
+        ::close(file);
+        return false;
+    }
+    created = st.st_size == 0;
+    if (created && ftruncate(file, size) != 0) {
+        WARN("Could not create preset library %s", path.c_str());
+        ::close(file);
+        return false;
+    }
+
+    void* view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (view == MAP_FAILED) {
+        WARN("Could not map preset library %s", path.c_str());
+        ::close(file);
+        return false;
+    }
+    fd = file;
+    mapping = view;
+#endif
+    mappingSize = size;
+
+    Header* header = static_cast<Header*>(mapping);
+    if (created) {
+        // New file: all records are zero (empty), only the header needs writing
+        std::memcpy(header->magic, "LCXP", 4);
+        header->version = VERSION;
+        header->recordSize = sizeof(PresetRecord);
+        header->capacity = CAPACITY;
+    } else if (std::memcmp(header->magic, "LCXP", 4) != 0 || header->version != VERSION
+               || header->recordSize != sizeof(PresetRecord) || header->capacity != CAPACITY) {
+        WARN("Preset library %s has an incompatible format, ignoring it", path.c_str());
+        close();
+        return false;
+    }
+
+    // Touch every page now, so the audio thread never waits for the disk
+    volatile const uint8_t* bytes = static_cast<const uint8_t*>(mapping);
+    uint8_t sum = 0;
+    for (size_t i = 0; i < mappingSize; i += 4096) {
+        sum += bytes[i];
+    }
+    (void) sum;
+
+    records = reinterpret_cast<PresetRecord*>(static_cast<uint8_t*>(mapping) + sizeof(Header));
+    return true;
+}
+
+void PresetLibrary::close() {
+    records = nullptr;
+#if defined ARCH_WIN
+    if (mapping) UnmapViewOfFile(mapping);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (mapping) munmap(mapping, mappingSize);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+void PresetLibrary::sync() {
+    if (!mapping) return;
+#if defined ARCH_WIN
+    FlushViewOfFile(mapping, mappingSize);
+#else
+    msync(mapping, mappingSize, MS_ASYNC);
+#endif
+}
+
+bool PresetLibrary::read(int index, PresetRecord* record) const {
+    const PresetRecord* source = get(index);
+    if (!source) return false;
+    uint32_t before = writeCount.load(std::memory_order_acquire);
+    if (before & 1) return false;
+    std::memcpy(record, source, sizeof(PresetRecord));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return writeCount.load(std::memory_order_relaxed) == before;
+}
+
+bool PresetLibrary::write(int index, const PresetRecord& record) {
+    if (!records || index < 0 || index >= CAPACITY) return false;
+    writeCount.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&records[index], &record, sizeof(PresetRecord));
+    writeCount.fetch_add(1, std::memory_order_release);
+    sync();
+    return true;
+}
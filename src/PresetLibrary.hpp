@@ -0,0 +1,67 @@
+#pragma once
+#include "SequencerEngine.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Preset library: a file of fixed-size PresetRecords shared by all Cores.
+//
+// The file is memory-mapped and all of its pages are touched when it is opened,
+// so browsing presets from the controller (on the audio thread) is a plain memory
+// read: no JSON parsing and no disk access. Stored records reach the disk through
+// the OS page cache.
+//
+// Layout: Header, then CAPACITY records. Files written by a build with a different
+// record layout are rejected instead of being reinterpreted.
+struct PresetLibrary {
+    static constexpr int CAPACITY = 256;  // 16 groups of 16 records
+    static constexpr uint32_t VERSION = 4;  // 2: paged step bits, 3: trig conditions, 4: density
+
+    struct Header {
+        char magic[4];        // "LCXP"
+        uint32_t version;
+        uint32_t recordSize;  // sizeof(PresetRecord)
+        uint32_t capacity;
+    };
+
+    PresetLibrary() {}
+    ~PresetLibrary() { close(); }
+    PresetLibrary(const PresetLibrary&) = delete;
+    PresetLibrary& operator=(const PresetLibrary&) = delete;
+
+    // Map the library file, creating it if it doesn't exist. Returns false if the
+    // file can't be opened or has an incompatible layout.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return records != nullptr; }
+
+    // Record by index (0 to CAPACITY-1), nullptr if out of range or not open.
+    // For display only: use read() for a record that is loaded into a sequencer.
+    const PresetRecord* get(int index) const {
+        return (records && index >= 0 && index < CAPACITY) ? &records[index] : nullptr;
+    }
+
+    // Records are written from the UI thread while the audio threads of every Core
+    // may be copying them. A write makes the shared write count odd while it runs;
+    // read() copies a record and returns false if a write ran meanwhile, so the
+    // caller tries again later instead of loading a half-written record.
+    bool read(int index, PresetRecord* record) const;
+    bool write(int index, const PresetRecord& record);
+
+    // Schedule written records to be saved to disk (non-blocking)
+    void sync();
+
+private:
+    static std::atomic<uint32_t> writeCount;  // Shared by the mappings of all Cores
+
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    PresetRecord* records = nullptr;
+#if defined ARCH_WIN
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
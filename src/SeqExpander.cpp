@@ -37,13 +37,17 @@ struct SeqExpander : Module {
         LIGHTS_LEN
     };
 
-    LCXLExpanderMessage leftMessages[2];
-    LCXLExpanderMessage expanderMessage;  // For forwarding to right
+    LCXLChainLink link;  // Core's shared snapshot, received from the left and passed on
+    dsp::ClockDivider controlDivider;  // Control-rate scheduler, division follows Core
     dsp::PulseGenerator triggerPulsesA[8];
     dsp::PulseGenerator triggerPulsesB[8];
+    uint32_t triggerCountA[8] = {0};  // Core's trigger counters as of the last fired trigger
+    uint32_t triggerCountB[8] = {0};
+    const LCXLSnapshot* countedSnapshot = nullptr;  // Snapshot the counters belong to
 
     SeqExpander() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+        controlDivider.setDivision(32);
 
         // Configure trigger outputs
         for (int i = 0; i < 8; i++) {
@@ -58,8 +62,7 @@ struct SeqExpander : Module {
         }
 
         // Setup expander message buffers
-        leftExpander.producerMessage = &leftMessages[0];
-        leftExpander.consumerMessage = &leftMessages[1];
+        link.attach(this);
     }
 
     bool isValidExpander(Module* m) {
@@ -70,49 +73,50 @@ struct SeqExpander : Module {
     }
 
     void process(const ProcessArgs& args) override {
-        bool connected = false;
-        LCXLExpanderMessage* msg = nullptr;
+        bool controlTick = controlDivider.process();  // Lights/display run at Core's control rate
 
-        // Check if connected to Core or another expander on the left
-        if (isValidExpander(leftExpander.module)) {
-            msg = reinterpret_cast<LCXLExpanderMessage*>(leftExpander.consumerMessage);
-            if (msg && msg->moduleId >= 0) {
-                connected = true;
+        // Get Core's snapshot from the left neighbour and pass it on to the right
+        bool fresh = false;  // Core published since the last frame
+        const LCXLExpanderMessage* msg = link.receive(this, isValidExpander(leftExpander.module), &fresh);
+        bool connected = msg != nullptr;
+        link.forward(rightExpander.module);
 
+        if (connected) {
+            controlDivider.setDivision(msg->controlRateDivision);
+
+            // A new Core: take over its counters without firing
+            if (countedSnapshot != link.snapshot.get()) {
+                countedSnapshot = link.snapshot.get();
                 for (int s = 0; s < 8; s++) {
-                    auto& seq = msg->sequencers[s];
-                    int layout = s + 1;  // Sequencers use layouts 1-8
-
-                    // Fire trigger A if sequencer triggered this frame
-                    if (seq.triggeredA) {
-                        triggerPulsesA[s].trigger(1e-3f);  // 1ms pulse
-                    }
-
-                    // Fire trigger B if sequencer triggered this frame
-                    if (seq.triggeredB) {
-                        triggerPulsesB[s].trigger(1e-3f);  // 1ms pulse
-                    }
-
-                    // Output triggers
-                    outputs[TRIG_A_OUTPUT + s].setVoltage(triggerPulsesA[s].process(args.sampleTime) ? 10.f : 0.f);
-                    outputs[TRIG_B_OUTPUT + s].setVoltage(triggerPulsesB[s].process(args.sampleTime) ? 10.f : 0.f);
-
-                    // Output slewed CV (with glide already applied by Core)
-                    outputs[CV_A_OUTPUT + s].setVoltage(seq.slewedCVA);
-                    outputs[CV_B_OUTPUT + s].setVoltage(seq.slewedCVB);
+                    triggerCountA[s] = msg->sequencers[s].triggerCountA;
+                    triggerCountB[s] = msg->sequencers[s].triggerCountB;
                 }
-
-                // Store for forwarding
-                expanderMessage = *msg;
             }
-        }
 
-        // Forward message to right expander
-        if (rightExpander.module && connected) {
-            LCXLExpanderMessage* rightMsg = reinterpret_cast<LCXLExpanderMessage*>(rightExpander.module->leftExpander.producerMessage);
-            if (rightMsg) {
-                *rightMsg = expanderMessage;
-                rightExpander.module->leftExpander.messageFlipRequested = true;
+            for (int s = 0; s < 8; s++) {
+                auto& seq = msg->sequencers[s];
+                int layout = s + 1;  // Sequencers use layouts 1-8
+
+                // Fire trigger A if sequencer triggered since the last trigger we fired
+                // (length set by Core, aligned to the sub-sample clock edge it reported)
+                if (seq.triggerCountA != triggerCountA[s]) {
+                    triggerCountA[s] = seq.triggerCountA;
+                    triggerPulsesA[s].trigger(seq.triggerLengthA - seq.triggerOffsetA * args.sampleTime);
+                }
+
+                // Fire trigger B if sequencer triggered since the last trigger we fired
+                if (seq.triggerCountB != triggerCountB[s]) {
+                    triggerCountB[s] = seq.triggerCountB;
+                    triggerPulsesB[s].trigger(seq.triggerLengthB - seq.triggerOffsetB * args.sampleTime);
+                }
+
+                // Output triggers
+                outputs[TRIG_A_OUTPUT + s].setVoltage(triggerPulsesA[s].process(args.sampleTime) ? 10.f : 0.f);
+                outputs[TRIG_B_OUTPUT + s].setVoltage(triggerPulsesB[s].process(args.sampleTime) ? 10.f : 0.f);
+
+                // Output slewed CV (with glide already applied by Core)
+                outputs[CV_A_OUTPUT + s].setVoltage(seq.slewedCVA);
+                outputs[CV_B_OUTPUT + s].setVoltage(seq.slewedCVB);
             }
         }
 
@@ -126,7 +130,9 @@ struct SeqExpander : Module {
             }
         }
 
-        lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        if (controlTick) {
+            lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        }
     }
 };
 
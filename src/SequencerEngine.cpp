@@ -0,0 +1,752 @@
+#include "SequencerEngine.hpp"
+#include <cstring>
+
+namespace {
+
+// Compile-time index list 0 to N-1 (std::index_sequence is C++14), built by halving
+// so the template depth stays logarithmic
+template <int... I>
+struct IndexList {};
+template <typename A, typename B>
+struct JoinIndexLists;
+template <int... A, int... B>
+struct JoinIndexLists<IndexList<A...>, IndexList<B...>> {
+    typedef IndexList<A..., (int) sizeof...(A) + B...> type;
+};
+template <int N>
+struct MakeIndexList {
+    typedef typename JoinIndexLists<typename MakeIndexList<N / 2>::type,
+                                    typename MakeIndexList<N - N / 2>::type>::type type;
+};
+template <>
+struct MakeIndexList<0> { typedef IndexList<> type; };
+template <>
+struct MakeIndexList<1> { typedef IndexList<0> type; };
+
+constexpr int EUCLIDEAN_SIZE = Sequencer::MAX_STEPS + 1;  // Hits and lengths 0-MAX_STEPS
+
+// Onsets j to hits-1 of a Euclidean rhythm. Onset j lands on step ceil(j * length / hits),
+// which are exactly the steps i with (i * hits) % length < hits.
+constexpr uint64_t euclideanOnsets(int hits, int length, int j) {
+    return j >= hits ? 0 : (1ull << ((j * length + hits - 1) / hits)) | euclideanOnsets(hits, length, j + 1);
+}
+
+struct EuclideanTable {
+    uint64_t steps[EUCLIDEAN_SIZE * EUCLIDEAN_SIZE];  // [length][hits]
+};
+
+template <int... I>
+constexpr EuclideanTable makeEuclideanTable(IndexList<I...>) {
+    return EuclideanTable{{(I % EUCLIDEAN_SIZE <= I / EUCLIDEAN_SIZE
+                                ? euclideanOnsets(I % EUCLIDEAN_SIZE, I / EUCLIDEAN_SIZE, 0) : 0)...}};
+}
+
+constexpr EuclideanTable EUCLIDEAN_TABLE =
+    makeEuclideanTable(MakeIndexList<EUCLIDEAN_SIZE * EUCLIDEAN_SIZE>::type());
+
+static_assert(EUCLIDEAN_TABLE.steps[8 * EUCLIDEAN_SIZE + 3] == 0x49, "E(3,8) = x..x..x.");
+
+// Whether the density lets step `localStep` of a `length`-step loop play
+bool isKeptByDensity(const Sequencer& seq, int localStep, int length) {
+    float density = std::min(std::max(seq.density + seq.densityOffset, 0.f), 1.f);
+    int hits = (int) (density * length + 0.5f);
+    return (euclideanSteps(hits, length) >> localStep) & 1;
+}
+
+// Offset and length of sequence A (which = 0) or B (1) in the step bits (length 0 = none)
+int sequenceSpan(const Sequencer& seq, int which, int* offset) {
+    *offset = which == 0 ? 0 : 8;
+    if (which == 0) return seq.stepLengthA;
+    return seq.isStepSingleMode() ? 0 : seq.stepLengthB;
+}
+
+}  // namespace
+
+uint64_t euclideanSteps(int hits, int length) {
+    length = std::min(std::max(length, 0), (int) Sequencer::MAX_STEPS);
+    hits = std::min(std::max(hits, 0), length);
+    return EUCLIDEAN_TABLE.steps[length * EUCLIDEAN_SIZE + hits];
+}
+
+uint64_t rotateSteps(uint64_t bits, int length, int amount) {
+    if (length <= 0) return 0;
+    uint64_t mask = length >= 64 ? ~0ull : (1ull << length) - 1;
+    amount = ((amount % length) + length) % length;
+    bits &= mask;
+    if (amount == 0) return bits;
+    return ((bits << amount) | (bits >> (length - amount))) & mask;
+}
+
+ClockResult SequencerEngine::processClock(int seqIndex, bool clockARose, bool clockBRose) {
+    ClockResult result;
+    if (sequencers[seqIndex].isStepSingleMode()) {
+        // Single step mode: only use Clock A
+        if (clockARose) {
+            result = processSequencerClockSingle(seqIndex);
+        }
+    } else {
+        // Dual step mode: Clock A for Seq A, Clock B for Seq B.
+        // A loser in echo mode fires on its next clock, regardless of the step.
+        Sequencer& seq = sequencers[seqIndex];
+        if (clockARose) {
+            result.echoA = seq.pendingEchoA;
+            seq.pendingEchoA = false;
+            result.fireA = processSequencerClockDualA(seqIndex);
+        }
+        if (clockBRose) {
+            result.echoB = seq.pendingEchoB;
+            seq.pendingEchoB = false;
+            result.fireB = processSequencerClockDualB(seqIndex);
+        }
+    }
+    return result;
+}
+
+ClockResult SequencerEngine::processSequencerClockSingle(int seqIndex) {
+    Sequencer& seq = sequencers[seqIndex];
+    ClockResult result;
+
+    // Advance step
+    seq.currentStepA = (seq.currentStepA + 1) % seq.stepLengthA;
+    if (seq.currentStepA == 0) {
+        seq.loopA++;
+        evaluateConditions(seqIndex, seq.stepMaskA());
+    }
+
+    // Check if step is active (and its condition holds)
+    if (!seq.isStepPlayable(seq.currentStepA)) return result;
+    if (!isKeptByDensity(seq, seq.currentStepA, seq.stepLengthA)) return result;
+
+    // Advance value index
+    seq.currentValueIndexA = (seq.currentValueIndexA + 1) % seq.valueLengthA;
+
+    // Determine routing destination
+    routingKernels[seqIndex](seq, rng, result);
+
+    return result;
+}
+
+bool SequencerEngine::processSequencerClockDualA(int seqIndex) {
+    Sequencer& seq = sequencers[seqIndex];
+
+    // Advance step A
+    seq.currentStepA = (seq.currentStepA + 1) % seq.stepLengthA;
+    if (seq.currentStepA == 0) {
+        seq.loopA++;
+        evaluateConditions(seqIndex, seq.stepMaskA());
+    }
+
+    // Check if step is active (top row buttons = steps 0-7)
+    if (!seq.isStepPlayable(seq.currentStepA)) return false;
+    if (!isKeptByDensity(seq, seq.currentStepA, seq.stepLengthA)) return false;
+
+    // Check for competition with B
+    bool aWantsToFire = true;
+    int stepB = seq.stepLengthB > 0 ? seq.currentStepB % seq.stepLengthB : 0;
+    bool bWantsToFire = (seq.stepLengthB > 0) && seq.isStepPlayable(8 + stepB)
+                        && isKeptByDensity(seq, stepB, seq.stepLengthB);
+
+    seq.theftA = false;
+    bool aWins = resolveCompetition(seqIndex, aWantsToFire, bWantsToFire, true);
+
+    if (aWins) {
+        // A fires - advance value index (B's, if A stole B's value)
+        if (seq.theftA) {
+            seq.currentValueIndexB = (seq.currentValueIndexB + 1) % seq.valueLengthB;
+            seq.stolenKnobA = 8 + seq.currentValueIndexB;
+        } else {
+            seq.currentValueIndexA = (seq.currentValueIndexA + 1) % seq.valueLengthA;
+        }
+    }
+    return aWins;
+}
+
+bool SequencerEngine::processSequencerClockDualB(int seqIndex) {
+    Sequencer& seq = sequencers[seqIndex];
+
+    // B disabled if length is 0
+    if (seq.stepLengthB <= 0) return false;
+
+    // Advance step B
+    seq.currentStepB = (seq.currentStepB + 1) % seq.stepLengthB;
+    if (seq.currentStepB == 0) {
+        seq.loopB++;
+        evaluateConditions(seqIndex, seq.stepMaskB());
+    }
+
+    // Check if step is active (bottom row buttons = steps 8-15)
+    if (!seq.isStepPlayable(8 + seq.currentStepB)) return false;
+    if (!isKeptByDensity(seq, seq.currentStepB, seq.stepLengthB)) return false;
+
+    // Check for competition with A
+    int stepA = seq.currentStepA % seq.stepLengthA;
+    bool aWantsToFire = seq.isStepPlayable(stepA) && isKeptByDensity(seq, stepA, seq.stepLengthA);
+    bool bWantsToFire = true;
+
+    seq.theftB = false;
+    bool bWins = !resolveCompetition(seqIndex, aWantsToFire, bWantsToFire, false);
+
+    if (bWins) {
+        // B fires - advance value index (A's, if B stole A's value)
+        if (seq.theftB) {
+            seq.currentValueIndexA = (seq.currentValueIndexA + 1) % seq.valueLengthA;
+            seq.stolenKnobB = seq.currentValueIndexA;
+        } else if (seq.valueLengthB > 0) {
+            seq.currentValueIndexB = (seq.currentValueIndexB + 1) % seq.valueLengthB;
+        }
+    }
+    return bWins;
+}
+
+void SequencerEngine::previewClock(Sequencer& seq, bool clockA, bool clockB) {
+    if (seq.isStepSingleMode()) {
+        if (clockA) {
+            seq.currentStepA = (seq.currentStepA + 1) % seq.stepLengthA;
+            if (seq.isStepPlayable(seq.currentStepA)) {
+                seq.currentValueIndexA = (seq.currentValueIndexA + 1) % seq.valueLengthA;
+            }
+        }
+        return;
+    }
+    if (clockA) {
+        seq.currentStepA = (seq.currentStepA + 1) % seq.stepLengthA;
+        if (seq.isStepPlayable(seq.currentStepA)) {
+            seq.currentValueIndexA = (seq.currentValueIndexA + 1) % seq.valueLengthA;
+        }
+    }
+    if (clockB && seq.stepLengthB > 0) {
+        seq.currentStepB = (seq.currentStepB + 1) % seq.stepLengthB;
+        if (seq.isStepPlayable(8 + seq.currentStepB) && seq.valueLengthB > 0) {
+            seq.currentValueIndexB = (seq.currentValueIndexB + 1) % seq.valueLengthB;
+        }
+    }
+}
+
+bool SequencerEngine::resolveCompetition(int seqIndex, bool aWants, bool bWants, bool isAClock) {
+    // If only one wants to fire, they win
+    if (aWants && !bWants) return true;
+    if (bWants && !aWants) return false;
+    if (!aWants && !bWants) return isAClock;  // Neither wants, default
+
+    // Both want to fire - competition!
+    return competitionKernels[seqIndex](sequencers[seqIndex], rng, isAClock);
+}
+
+// Competition kernels (called only when A and B both want to fire)
+
+template <>
+bool competitionKernel<COMP_INDEPENDENT>(Sequencer& seq, EngineRandom& rng, bool isAClock) {
+    // Both can fire - let each win on their own clock
+    return isAClock;  // A wins on A's clock, B wins on B's clock
+}
+
+template <>
+bool competitionKernel<COMP_STEAL>(Sequencer& seq, EngineRandom& rng, bool isAClock) {
+    // Bernoulli decides
+    return rng.uniform() >= seq.bias;
+}
+
+template <>
+bool competitionKernel<COMP_A_PRIORITY>(Sequencer& seq, EngineRandom& rng, bool isAClock) {
+    // A wins if bias is high enough
+    return rng.uniform() < (0.5f + seq.bias * 0.5f);
+}
+
+template <>
+bool competitionKernel<COMP_B_PRIORITY>(Sequencer& seq, EngineRandom& rng, bool isAClock) {
+    // B wins if bias is high enough
+    return rng.uniform() >= (0.5f + seq.bias * 0.5f);
+}
+
+template <>
+bool competitionKernel<COMP_MOMENTUM>(Sequencer& seq, EngineRandom& rng, bool isAClock) {
+    // Winner gets boost next time
+    bool aWins = rng.uniform() < seq.momentumA;
+    if (aWins) {
+        seq.momentumA = std::min(1.0f, seq.momentumA + seq.bias * 0.2f);
+        seq.momentumB = std::max(0.0f, seq.momentumB - seq.bias * 0.1f);
+    } else {
+        seq.momentumB = std::min(1.0f, seq.momentumB + seq.bias * 0.2f);
+        seq.momentumA = std::max(0.0f, seq.momentumA - seq.bias * 0.1f);
+    }
+    return aWins;
+}
+
+template <>
+bool competitionKernel<COMP_REVENGE>(Sequencer& seq, EngineRandom& rng, bool isAClock) {
+    // Loser gets boost next time
+    bool aWins;
+    if (seq.lastWinnerA) {
+        // B has revenge chance
+        aWins = rng.uniform() >= seq.bias * 0.7f;
+    } else {
+        // A has revenge chance
+        aWins = rng.uniform() < (1.0f - seq.bias * 0.7f);
+    }
+    seq.lastWinnerA = aWins;
+    return aWins;
+}
+
+template <>
+bool competitionKernel<COMP_ECHO>(Sequencer& seq, EngineRandom& rng, bool isAClock) {
+    // Winner fires, loser echoes on next clock
+    if (isAClock) {
+        bool aWins = rng.uniform() >= seq.bias;
+        if (!aWins) seq.pendingEchoA = true;
+        return aWins;
+    } else {
+        bool bWins = rng.uniform() < seq.bias;
+        if (!bWins) seq.pendingEchoB = true;
+        return !bWins;
+    }
+}
+
+template <>
+bool competitionKernel<COMP_VALUE_THEFT>(Sequencer& seq, EngineRandom& rng, bool isAClock) {
+    // Bernoulli decides like steal, but a winner on its own clock plays the
+    // loser's next value instead of its own (the loser's value is used up)
+    bool aWins = rng.uniform() >= seq.bias;
+    if (!seq.isValueSingleMode() && seq.valueLengthB > 0) {
+        if (isAClock) seq.theftA = aWins;
+        else seq.theftB = !aWins;
+    }
+    return aWins;
+}
+
+// Routing kernels (single mode, called for every fired step)
+
+template <>
+void routingKernel<ROUTE_ALL_A>(Sequencer& seq, EngineRandom& rng, ClockResult& result) {
+    result.fireA = true;
+}
+
+template <>
+void routingKernel<ROUTE_ALL_B>(Sequencer& seq, EngineRandom& rng, ClockResult& result) {
+    result.fireB = true;
+}
+
+template <>
+void routingKernel<ROUTE_BERNOULLI>(Sequencer& seq, EngineRandom& rng, ClockResult& result) {
+    if (rng.uniform() < seq.bias) result.fireB = true;
+    else result.fireA = true;
+}
+
+template <>
+void routingKernel<ROUTE_ALTERNATE>(Sequencer& seq, EngineRandom& rng, ClockResult& result) {
+    if (seq.alternateCounter % 2 == 0) result.fireA = true;
+    else result.fireB = true;
+    seq.alternateCounter++;
+}
+
+template <>
+void routingKernel<ROUTE_TWO_TWO>(Sequencer& seq, EngineRandom& rng, ClockResult& result) {
+    if ((seq.alternateCounter / 2) % 2 == 0) result.fireA = true;
+    else result.fireB = true;
+    seq.alternateCounter++;
+}
+
+template <>
+void routingKernel<ROUTE_BURST>(Sequencer& seq, EngineRandom& rng, ClockResult& result) {
+    // Random bursts - bias controls probability of switching
+    if (rng.uniform() < seq.bias * 0.3f) seq.burstToA = !seq.burstToA;
+    if (seq.burstToA) result.fireA = true;
+    else result.fireB = true;
+}
+
+template <>
+void routingKernel<ROUTE_PROBABILITY>(Sequencer& seq, EngineRandom& rng, ClockResult& result) {
+    if (rng.uniform() < seq.bias) result.fireB = true;
+    else result.fireA = true;
+}
+
+template <>
+void routingKernel<ROUTE_PATTERN>(Sequencer& seq, EngineRandom& rng, ClockResult& result) {
+    // Odd steps to A, even to B
+    if (seq.currentStepA % 2 == 0) result.fireA = true;
+    else result.fireB = true;
+}
+
+SequencerEngine::SequencerEngine() {
+    for (int s = 0; s < 8; s++) {
+        setCompetitionMode(s, sequencers[s].competitionMode);
+        setRoutingMode(s, sequencers[s].routingMode);
+    }
+}
+
+CompetitionKernel SequencerEngine::getCompetitionKernel(int mode) {
+    static const CompetitionKernel kernels[8] = {
+        competitionKernel<COMP_INDEPENDENT>,
+        competitionKernel<COMP_STEAL>,
+        competitionKernel<COMP_A_PRIORITY>,
+        competitionKernel<COMP_B_PRIORITY>,
+        competitionKernel<COMP_MOMENTUM>,
+        competitionKernel<COMP_REVENGE>,
+        competitionKernel<COMP_ECHO>,
+        competitionKernel<COMP_VALUE_THEFT>
+    };
+    return kernels[(mode >= 0 && mode < 8) ? mode : 0];
+}
+
+RoutingKernel SequencerEngine::getRoutingKernel(int mode) {
+    static const RoutingKernel kernels[8] = {
+        routingKernel<ROUTE_ALL_A>,
+        routingKernel<ROUTE_ALL_B>,
+        routingKernel<ROUTE_BERNOULLI>,
+        routingKernel<ROUTE_ALTERNATE>,
+        routingKernel<ROUTE_TWO_TWO>,
+        routingKernel<ROUTE_BURST>,
+        routingKernel<ROUTE_PROBABILITY>,
+        routingKernel<ROUTE_PATTERN>
+    };
+    return kernels[(mode >= 0 && mode < 8) ? mode : 0];
+}
+
+void SequencerEngine::setCompetitionMode(int seqIndex, int mode) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.competitionMode = (mode >= 0 && mode < 8) ? mode : COMP_INDEPENDENT;
+    seq.theftA = false;
+    seq.theftB = false;
+    competitionKernels[seqIndex] = getCompetitionKernel(seq.competitionMode);
+}
+
+void SequencerEngine::setRoutingMode(int seqIndex, int mode) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.routingMode = (mode >= 0 && mode < 8) ? mode : ROUTE_ALL_A;
+    routingKernels[seqIndex] = getRoutingKernel(seq.routingMode);
+}
+
+void SequencerEngine::setValueLengthA(int seqIndex, int knobValue) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.valueLengthA = 1 + (knobValue * 15 / 127);  // Map 0-127 to 1-16
+    lengthRevision++;
+    if (seq.currentValueIndexA >= seq.valueLengthA) {
+        seq.currentValueIndexA = 0;
+    }
+}
+
+void SequencerEngine::setValueLengthB(int seqIndex, int knobValue) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.valueLengthB = knobValue * 9 / 128;  // Map 0-127 to 0-8
+    if (seq.valueLengthB > 0 && seq.currentValueIndexB >= seq.valueLengthB) {
+        seq.currentValueIndexB = 0;
+    }
+}
+
+void SequencerEngine::setStepLengthA(int seqIndex, int knobValue) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.stepLengthA = 1 + (knobValue * (16 * seq.pages - 1) / 127);  // Map 0-127 to 1-16 per page
+    lengthRevision++;
+    if (seq.currentStepA >= seq.stepLengthA) {
+        seq.currentStepA = 0;
+    }
+}
+
+void SequencerEngine::setStepLengthB(int seqIndex, int knobValue) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.stepLengthB = knobValue * 9 / 128;  // Map 0-127 to 0-8
+    if (seq.stepLengthB > 0 && seq.currentStepB >= seq.stepLengthB) {
+        seq.currentStepB = 0;
+    }
+}
+
+void SequencerEngine::setBias(int seqIndex, int knobValue) {
+    sequencers[seqIndex].bias = knobValue / 127.f;
+}
+
+// Steps whose loop ratio condition fails in `loop`
+static uint64_t ratioFailures(const uint64_t* conditionSteps, uint32_t loop) {
+    // -(uint64_t) b is all ones if b holds, so no step needs its own branch
+    return (conditionSteps[COND_1_2 - 1] & -(uint64_t) (loop % 2 != 0))
+         | (conditionSteps[COND_2_2 - 1] & -(uint64_t) (loop % 2 != 1))
+         | (conditionSteps[COND_1_4 - 1] & -(uint64_t) (loop % 4 != 0))
+         | (conditionSteps[COND_3_4 - 1] & -(uint64_t) (loop % 4 != 2));
+}
+
+void SequencerEngine::evaluateConditions(int seqIndex, uint64_t mask) {
+    Sequencer& seq = sequencers[seqIndex];
+    const uint64_t* c = seq.conditionSteps;
+    uint64_t maskB = seq.stepMaskB();
+
+    // Loop ratios count A's loops, or B's for B's steps
+    uint64_t failures = (ratioFailures(c, seq.loopA) & ~maskB) | (ratioFailures(c, seq.loopB) & maskB);
+    failures |= (c[COND_FILL - 1] & -(uint64_t) !seq.fill) | (c[COND_NOT_FILL - 1] & -(uint64_t) seq.fill);
+
+    // Probabilities: each bit of a random word is a fair coin, so one word decides
+    // every 50% step and two words every 25%/75% step
+    uint64_t random = c[COND_PROB_75 - 1] | c[COND_PROB_50 - 1] | c[COND_PROB_25 - 1];
+    if (random & mask) {
+        uint64_t r1 = rng.next();
+        uint64_t r2 = rng.next();
+        failures |= (c[COND_PROB_75 - 1] & r1 & r2)
+                  | (c[COND_PROB_50 - 1] & r1)
+                  | (c[COND_PROB_25 - 1] & (r1 | r2));
+    }
+
+    seq.playableSteps = (seq.playableSteps & ~mask) | (~failures & mask);
+}
+
+void SequencerEngine::setStepCondition(int seqIndex, int step, int condition) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.setCondition(step, (condition >= 0 && condition < NUM_CONDITIONS) ? condition : COND_ALWAYS);
+    evaluateConditions(seqIndex, 1ull << step);
+}
+
+void SequencerEngine::setFill(int seqIndex, bool fill) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.fill = fill;
+    evaluateConditions(seqIndex, seq.conditionSteps[COND_FILL - 1] | seq.conditionSteps[COND_NOT_FILL - 1]);
+}
+
+void SequencerEngine::clampLengths(int seqIndex) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.valueLengthA = std::min(std::max(seq.valueLengthA, 1), 16);
+    seq.valueLengthB = std::min(std::max(seq.valueLengthB, 0), 8);
+    seq.stepLengthA = std::min(std::max(seq.stepLengthA, 1), 16 * seq.pages);
+    seq.stepLengthB = std::min(std::max(seq.stepLengthB, 0), 8);
+    lengthRevision++;
+
+    if (seq.currentStepA >= seq.stepLengthA) seq.currentStepA = 0;
+    if (seq.currentValueIndexA >= seq.valueLengthA) seq.currentValueIndexA = 0;
+    if (seq.stepLengthB > 0 && seq.currentStepB >= seq.stepLengthB) seq.currentStepB = 0;
+    if (seq.valueLengthB > 0 && seq.currentValueIndexB >= seq.valueLengthB) seq.currentValueIndexB = 0;
+}
+
+void SequencerEngine::setPages(int seqIndex, int pages) {
+    Sequencer& seq = sequencers[seqIndex];
+    if (pages < 1) pages = 1;
+    if (pages > Sequencer::MAX_PAGES) pages = Sequencer::MAX_PAGES;
+    bool allPages = seq.stepLengthA == 16 * seq.pages;
+    seq.pages = pages;
+    lengthRevision++;
+    seq.steps &= seq.pageMask();
+    for (int c = 0; c < NUM_CONDITIONS - 1; c++) {
+        seq.conditionSteps[c] &= seq.pageMask();
+    }
+    if (allPages || seq.stepLengthA > 16 * pages) {
+        seq.stepLengthA = 16 * pages;
+    }
+    if (seq.currentStepA >= seq.stepLengthA) {
+        seq.currentStepA = 0;
+    }
+}
+
+void SequencerEngine::resetPlayheads(int seqIndex) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.currentStepA = 0;
+    seq.currentStepB = 0;
+    seq.currentValueIndexA = 0;
+    seq.currentValueIndexB = 0;
+    seq.alternateCounter = 0;
+    seq.loopA = 0;
+    seq.loopB = 0;
+    evaluateConditions(seqIndex, ~0ull);
+}
+
+void SequencerEngine::resetAllPlayheads() {
+    for (int s = 0; s < 8; s++) {
+        resetPlayheads(s);
+    }
+}
+
+void SequencerEngine::copySequencer(int seqIndex) {
+    copyBuffer = sequencers[seqIndex];
+}
+
+void SequencerEngine::pasteSteps(int seqIndex) {
+    // Only the step pattern (with its conditions) is pasted, onto the pages in use
+    Sequencer& seq = sequencers[seqIndex];
+    seq.steps = copyBuffer.steps & seq.pageMask();
+    for (int c = 0; c < NUM_CONDITIONS - 1; c++) {
+        seq.conditionSteps[c] = copyBuffer.conditionSteps[c] & seq.pageMask();
+    }
+    evaluateConditions(seqIndex, ~0ull);
+}
+
+void SequencerEngine::clearSteps(int seqIndex) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.steps = 0;
+    std::fill(seq.conditionSteps, seq.conditionSteps + NUM_CONDITIONS - 1, 0ull);
+    seq.playableSteps = ~0ull;
+}
+
+void SequencerEngine::randomizeSteps(int seqIndex) {
+    Sequencer& seq = sequencers[seqIndex];
+    for (int i = 0; i < 16 * seq.pages; i++) {
+        seq.setStep(i, rng.uniform() > 0.5f);
+    }
+}
+
+void SequencerEngine::invertSteps(int seqIndex) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.steps = ~seq.steps & seq.pageMask();
+}
+
+void SequencerEngine::randomizeValues(int* values) {
+    for (int i = 0; i < 16; i++) {
+        values[i] = static_cast<int>(rng.uniform() * 127);
+    }
+}
+
+void SequencerEngine::euclideanFill(int seqIndex, int which, int hits) {
+    Sequencer& seq = sequencers[seqIndex];
+    int offset;
+    int length = sequenceSpan(seq, which, &offset);
+    if (length <= 0) return;
+    uint64_t mask = euclideanSteps(length, length) << offset;  // All steps of the sequence
+    seq.steps = (seq.steps & ~mask) | (euclideanSteps(hits, length) << offset);
+}
+
+void SequencerEngine::rotateSequence(int seqIndex, int which, int amount) {
+    Sequencer& seq = sequencers[seqIndex];
+    int offset;
+    int length = sequenceSpan(seq, which, &offset);
+    if (length <= 0) return;
+    uint64_t mask = euclideanSteps(length, length) << offset;
+    auto rotate = [&](uint64_t bits) {
+        return (bits & ~mask) | (rotateSteps(bits >> offset, length, amount) << offset);
+    };
+    seq.steps = rotate(seq.steps);
+    for (int c = 0; c < NUM_CONDITIONS - 1; c++) {
+        seq.conditionSteps[c] = rotate(seq.conditionSteps[c]);
+    }
+    evaluateConditions(seqIndex, mask);
+}
+
+void SequencerEngine::storePattern(int seqIndex, int slot, const int* knobs) {
+    capturePattern(seqIndex, knobs, &banks[seqIndex].patterns[slot]);
+}
+
+void SequencerEngine::capturePattern(int seqIndex, const int* knobs, Pattern* out) const {
+    const Sequencer& seq = sequencers[seqIndex];
+    Pattern& pattern = *out;
+    pattern.steps = seq.steps;
+    pattern.pages = seq.pages;
+    std::copy(seq.conditionSteps, seq.conditionSteps + NUM_CONDITIONS - 1, pattern.conditionSteps);
+    pattern.valueLengthA = seq.valueLengthA;
+    pattern.valueLengthB = seq.valueLengthB;
+    pattern.stepLengthA = seq.stepLengthA;
+    pattern.stepLengthB = seq.stepLengthB;
+    pattern.competitionMode = seq.competitionMode;
+    pattern.routingMode = seq.routingMode;
+    std::copy(seq.glideTime, seq.glideTime + 16, pattern.glideTime);
+    std::copy(knobs, knobs + 24, pattern.knobs);
+    pattern.density = seq.density;
+}
+
+void SequencerEngine::loadPattern(int seqIndex, int slot, int* knobs) {
+    Sequencer& seq = sequencers[seqIndex];
+    const Pattern& pattern = banks[seqIndex].patterns[slot];
+    seq.pages = std::min(std::max(pattern.pages, 1), (int) Sequencer::MAX_PAGES);
+    seq.steps = pattern.steps & seq.pageMask();
+    for (int c = 0; c < NUM_CONDITIONS - 1; c++) {
+        seq.conditionSteps[c] = pattern.conditionSteps[c] & seq.pageMask();
+    }
+    seq.valueLengthA = pattern.valueLengthA;
+    seq.valueLengthB = pattern.valueLengthB;
+    seq.stepLengthA = pattern.stepLengthA;
+    seq.stepLengthB = pattern.stepLengthB;
+    clampLengths(seqIndex);
+    setCompetitionMode(seqIndex, pattern.competitionMode);
+    setRoutingMode(seqIndex, pattern.routingMode);
+    std::copy(pattern.glideTime, pattern.glideTime + 16, seq.glideTime);
+    std::copy(pattern.knobs, pattern.knobs + 24, knobs);
+    seq.density = std::min(std::max(pattern.density, 0.f), 1.f);
+
+    // Parameter knobs 5-8 hold bias and CV 1-3
+    seq.bias = knobs[20] / 127.f;
+    seq.cv1 = knobs[21];
+    seq.cv2 = knobs[22];
+    seq.cv3 = knobs[23];
+
+    evaluateConditions(seqIndex, ~0ull);
+    banks[seqIndex].active = slot;
+}
+
+void SequencerEngine::queuePattern(int seqIndex, int slot) {
+    PatternBank& bank = banks[seqIndex];
+    bank.queued = (slot == bank.active) ? -1 : slot;
+}
+
+bool SequencerEngine::isPatternSwitchDue(int seqIndex, bool clockARose) const {
+    const Sequencer& seq = sequencers[seqIndex];
+    return clockARose && banks[seqIndex].queued >= 0 && seq.currentStepA + 1 >= seq.stepLengthA;
+}
+
+void SequencerEngine::switchToQueuedPattern(int seqIndex, int* knobs) {
+    PatternBank& bank = banks[seqIndex];
+    if (bank.queued < 0) return;
+    storePattern(seqIndex, bank.active, knobs);
+    loadPattern(seqIndex, bank.queued, knobs);
+    bank.queued = -1;
+    parkPlayheads(seqIndex);
+}
+
+void SequencerEngine::parkPlayheads(int seqIndex) {
+    Sequencer& seq = sequencers[seqIndex];
+    seq.currentStepA = seq.stepLengthA - 1;
+    seq.currentValueIndexA = seq.valueLengthA - 1;
+    seq.currentStepB = std::max(0, seq.stepLengthB - 1);
+    seq.currentValueIndexB = std::max(0, seq.valueLengthB - 1);
+    seq.alternateCounter = 0;
+    // The wrap of the next clock starts loop 0, so 1:2 steps play on the first loop
+    seq.loopA = ~0u;
+    seq.loopB = ~0u;
+}
+
+void SequencerEngine::storePreset(int seqIndex, const int* knobs, PresetRecord* record) const {
+    const Sequencer& seq = sequencers[seqIndex];
+    capturePattern(seqIndex, knobs, &record->pattern);
+    record->voltageRangeA = seq.voltageRangeA;
+    record->voltageRangeB = seq.voltageRangeB;
+    record->bipolarA = seq.bipolarA ? 1 : 0;
+    record->bipolarB = seq.bipolarB ? 1 : 0;
+    record->used = 1;
+}
+
+void SequencerEngine::loadPreset(int seqIndex, const PresetRecord* record, int* knobs) {
+    Sequencer& seq = sequencers[seqIndex];
+    PatternBank& bank = banks[seqIndex];
+    std::memcpy(&bank.patterns[bank.active], &record->pattern, sizeof(Pattern));
+    loadPattern(seqIndex, bank.active, knobs);
+    seq.voltageRangeA = std::min(std::max((int) record->voltageRangeA, 0), 2);
+    seq.voltageRangeB = std::min(std::max((int) record->voltageRangeB, 0), 2);
+    seq.bipolarA = record->bipolarA != 0;
+    seq.bipolarB = record->bipolarB != 0;
+}
+
+template <typename T>
+void SequencerEngine::processSlew(int seqIndex, const T* values, float sampleTime) {
+    Sequencer& seq = sequencers[seqIndex];
+
+    // Knob each output plays; in value theft mode a winner plays the loser's value
+    // it took when it fired, even if the loser's own clock has moved on since
+    int ownIdxB = seq.isValueSingleMode() ? seq.currentValueIndexA : (8 + seq.currentValueIndexB);
+    int knobIdxA = seq.theftA ? seq.stolenKnobA : seq.currentValueIndexA;
+    int knobIdxB = seq.theftB ? seq.stolenKnobB : ownIdxB;
+
+    // Compute target CV A
+    int glideValA = seq.glideTime[knobIdxA];
+    if (glideValA == 0) {
+        // Fast path: no glide, direct assignment
+        seq.currentSlewA = knobToVoltage(values[knobIdxA], seq.voltageRangeA, seq.bipolarA);
+    } else {
+        float targetA = knobToVoltage(values[knobIdxA], seq.voltageRangeA, seq.bipolarA);
+        float glideTimeA = (glideValA / 127.f) * 3.f;
+        seq.currentSlewA = applySlewExp(seq.currentSlewA, targetA, glideTimeA, sampleTime);
+    }
+
+    // Compute target CV B
+    int glideValB = seq.glideTime[knobIdxB];
+    if (glideValB == 0) {
+        // Fast path: no glide, direct assignment
+        seq.currentSlewB = knobToVoltage(values[knobIdxB], seq.voltageRangeB, seq.bipolarB);
+    } else {
+        float targetB = knobToVoltage(values[knobIdxB], seq.voltageRangeB, seq.bipolarB);
+        float glideTimeB = (glideValB / 127.f) * 3.f;
+        seq.currentSlewB = applySlewExp(seq.currentSlewB, targetB, glideTimeB, sampleTime);
+    }
+}
+
+// Live (int MIDI) and morphed (float) knob values
+template void SequencerEngine::processSlew<int>(int, const int*, float);
+template void SequencerEngine::processSlew<float>(int, const float*, float);
@@ -0,0 +1,628 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+
+// Rack-independent sequencer engine.
+// Holds the 8 dual sequencers and all clock, competition, routing, utility and
+// slew logic. Only depends on the C++ standard library so it can be built and
+// exercised without the Rack SDK (see `make engine`).
+
+// Competition modes (dual mode)
+enum CompetitionMode {
+    COMP_INDEPENDENT = 0,
+    COMP_STEAL,
+    COMP_A_PRIORITY,
+    COMP_B_PRIORITY,
+    COMP_MOMENTUM,
+    COMP_REVENGE,
+    COMP_ECHO,
+    COMP_VALUE_THEFT
+};
+
+// Routing modes (single mode)
+enum RoutingMode {
+    ROUTE_ALL_A = 0,
+    ROUTE_ALL_B,
+    ROUTE_BERNOULLI,
+    ROUTE_ALTERNATE,
+    ROUTE_TWO_TWO,
+    ROUTE_BURST,
+    ROUTE_PROBABILITY,
+    ROUTE_PATTERN
+};
+
+// Per-step trig conditions. A step with a condition only plays in the loops
+// where the condition holds; A:B = the Ath of every B loops.
+enum StepCondition {
+    COND_ALWAYS = 0,
+    COND_PROB_75,
+    COND_PROB_50,
+    COND_PROB_25,
+    COND_1_2,
+    COND_2_2,
+    COND_1_4,
+    COND_3_4,
+    COND_FILL,       // Only while fill is on
+    COND_NOT_FILL,   // Only while fill is off
+    NUM_CONDITIONS
+};
+
+// xoroshiro128+ generator, same algorithm and float mapping as Rack's random::uniform()
+struct EngineRandom {
+    uint64_t state[2] = {0x9E3779B97F4A7C15ull, 0xD1B54A32D192ED03ull};
+
+    void seed(uint64_t a, uint64_t b) {
+        state[0] = a;
+        state[1] = b;
+        // Avoid the all-zero state, which would only ever produce zeros
+        if (state[0] == 0 && state[1] == 0) state[1] = 1;
+        // Shuffle the seed a few times
+        for (int i = 0; i < 10; i++) next();
+    }
+
+    uint64_t next() {
+        uint64_t s0 = state[0];
+        uint64_t s1 = state[1];
+        uint64_t result = s0 + s1;
+        s1 ^= s0;
+        state[0] = ((s0 << 55) | (s0 >> 9)) ^ s1 ^ (s1 << 14);
+        state[1] = (s1 << 36) | (s1 >> 28);
+        return result;
+    }
+
+    // Uniform float in [0, 1) with 24 bits of precision
+    float uniform() {
+        return (next() >> (64 - 24)) * 5.9604645e-08f;  // 2^-24
+    }
+};
+
+// State of one dual sequencer (A + B)
+struct Sequencer {
+    static constexpr int MAX_PAGES = 4;                  // Pages of 16 steps (single step mode)
+    static constexpr int MAX_STEPS = 16 * MAX_PAGES;
+
+    // Step on/off bits, bit i = step i. Page p is steps 16p to 16p+15, one per button.
+    // Dual step mode only uses page 0: A on steps 0-7, B on steps 8-15.
+    uint64_t steps = 0;
+    int pages = 1;                  // Pages in use (1-MAX_PAGES)
+
+    // Trig conditions: conditionSteps[c - 1] has the bits of the steps with condition c
+    // (COND_ALWAYS has no mask, a step is in at most one). They are evaluated once per
+    // loop into playableSteps, so a clock only tests a bit.
+    uint64_t conditionSteps[NUM_CONDITIONS - 1] = {0};
+    uint64_t playableSteps = ~0ull; // Steps whose condition holds in the current loop
+    uint32_t loopA = 0;             // Completed loops of A (all steps in single mode)
+    uint32_t loopB = 0;             // Completed loops of B
+    bool fill = false;              // Fill is on (COND_FILL / COND_NOT_FILL)
+
+    // Density: only the steps of a Euclidean rhythm with density * length hits play
+    float density = 1.f;            // Set on the controller (0-1)
+    float densityOffset = 0.f;      // Modulation added to density (DENSITY input)
+
+    // Length parameters (from knobs 1-4)
+    int valueLengthA = 8;           // Value length for Seq A (1-16, >=9 = single mode)
+    int valueLengthB = 4;           // Value length for Seq B (0-8, 0=disabled)
+    int stepLengthA = 8;            // Step length for Seq A (1-16 per page, >=9 = single mode)
+    int stepLengthB = 4;            // Step length for Seq B (0-8, 0=disabled)
+
+    // Bias and per-sequencer CV values (from knobs 5-8)
+    float bias = 0.5f;              // Competition/routing bias (0-1)
+    int cv1 = 0;                    // Per-sequencer CV 1 (MIDI 0-127)
+    int cv2 = 0;                    // Per-sequencer CV 2 (MIDI 0-127)
+    int cv3 = 0;                    // Per-sequencer CV 3 (MIDI 0-127)
+
+    // Mode selection
+    int competitionMode = COMP_INDEPENDENT;  // For dual mode
+    int routingMode = ROUTE_ALL_A;           // For single mode
+
+    // Voltage settings (0=5V green, 1=10V amber, 2=1V red)
+    int voltageRangeA = 0;
+    int voltageRangeB = 0;
+    bool bipolarA = false;
+    bool bipolarB = false;
+
+    // Playback state
+    int currentStepA = 0;           // Current step position for Seq A
+    int currentStepB = 0;           // Current step position for Seq B
+    int currentValueIndexA = 0;     // Current value index for Seq A
+    int currentValueIndexB = 0;     // Current value index for Seq B
+
+    // Momentum/revenge state for competition modes
+    float momentumA = 0.5f;         // Current win chance for A
+    float momentumB = 0.5f;         // Current win chance for B
+    bool lastWinnerA = true;        // Who won last (for revenge mode)
+    bool pendingEchoB = false;      // Echo pending for B
+    bool pendingEchoA = false;      // Echo pending for A
+    bool theftA = false;            // A is playing a value stolen from B (value theft mode)
+    bool theftB = false;            // B is playing a value stolen from A
+    int stolenKnobA = 0;            // Knob A plays while theftA, fixed when A fired
+    int stolenKnobB = 0;            // Knob B plays while theftB, fixed when B fired
+
+    // Routing state for single mode
+    int alternateCounter = 0;       // Counter for alternate/2+2 modes
+    bool burstToA = true;           // Current burst target for burst mode
+
+    // Trigger timing (scheduled through the per-sequencer event queue)
+    int ratchets = 1;               // Triggers per fired step (1-4), spread over one clock period
+    float swing = 0.5f;             // Swing amount (0.5 = straight, 0.66 = triplet feel), delays odd steps
+    float gateLength = 0.f;         // Gate length as fraction of clock period (0 = 1ms trigger)
+    int midiClockDivision = 6;      // MIDI clock ticks (24 per quarter note) per step, when MIDI clocked
+
+    // Per-step glide times (0 = instant, 127 = slow ~3 seconds)
+    int glideTime[16] = {0};        // Glide time for transition FROM each value position
+    float currentSlewA = 0.f;       // Current slewed CV output for A
+    float currentSlewB = 0.f;       // Current slewed CV output for B
+    int prevValueIndexA = 0;        // Previous value index for detecting transitions
+    int prevValueIndexB = 0;        // Previous value index for B
+    float activeGlideA = 0.f;       // Currently active glide time for A (seconds)
+    float activeGlideB = 0.f;       // Currently active glide time for B (seconds)
+
+    // Helper to check if values are in single mode (all 16 knobs for one seq)
+    bool isValueSingleMode() const { return valueLengthA >= 9; }
+    // Helper to check if steps are in single mode (all 16 buttons for one seq)
+    bool isStepSingleMode() const { return stepLengthA >= 9; }
+
+    bool getStep(int i) const { return (steps >> i) & 1; }
+    // Step is on and its condition holds in this loop
+    bool isStepPlayable(int i) const { return ((steps & playableSteps) >> i) & 1; }
+    void setStep(int i, bool on) {
+        if (on) steps |= 1ull << i;
+        else steps &= ~(1ull << i);
+    }
+    // The 16 steps of a page, bit i = button i
+    uint16_t getPage(int page) const { return (uint16_t) (steps >> (16 * page)); }
+    // Bits of the steps on the pages in use
+    uint64_t pageMask() const { return pages >= MAX_PAGES ? ~0ull : (1ull << (16 * pages)) - 1; }
+    // Steps played by A and by B (B only has steps in dual mode)
+    uint64_t stepMaskA() const { return isStepSingleMode() ? ~0ull : 0x00FFull; }
+    uint64_t stepMaskB() const { return isStepSingleMode() ? 0 : 0xFF00ull; }
+
+    int getCondition(int i) const {
+        for (int c = 1; c < NUM_CONDITIONS; c++) {
+            if ((conditionSteps[c - 1] >> i) & 1) return c;
+        }
+        return COND_ALWAYS;
+    }
+    void setCondition(int i, int condition) {
+        for (int c = 1; c < NUM_CONDITIONS; c++) {
+            if (c == condition) conditionSteps[c - 1] |= 1ull << i;
+            else conditionSteps[c - 1] &= ~(1ull << i);
+        }
+    }
+};
+
+// One stored pattern of a sequencer: everything that defines the sequence
+// (not playback state). Plain data, so storing and recalling is a struct copy.
+struct Pattern {
+    uint64_t steps = 0;
+    int pages = 1;
+    uint64_t conditionSteps[NUM_CONDITIONS - 1] = {0};
+    int valueLengthA = 8;
+    int valueLengthB = 4;
+    int stepLengthA = 8;
+    int stepLengthB = 4;
+    int competitionMode = COMP_INDEPENDENT;
+    int routingMode = ROUTE_ALL_A;
+    int glideTime[16] = {0};
+    int knobs[24] = {0};            // Layout knob values: 16 values + 8 parameters (MIDI 0-127)
+    float density = 1.f;
+};
+
+// Preallocated pattern slots of one sequencer.
+// The live sequencer is always loaded from `active` and written back to it
+// before switching, so edits are kept per slot.
+struct PatternBank {
+    static constexpr int SIZE = 16;
+    Pattern patterns[SIZE];
+    int active = 0;                 // Slot the live sequencer belongs to
+    int queued = -1;                // Slot to switch to at the next loop boundary (-1 = none)
+};
+
+// One record of the preset library file: a pattern plus the sequencer's output
+// voltage settings. Fixed-size plain data, so records are read straight out of
+// the mapped file.
+struct PresetRecord {
+    uint32_t used = 0;              // 0 = empty record
+    int32_t voltageRangeA = 0;
+    int32_t voltageRangeB = 0;
+    uint8_t bipolarA = 0;
+    uint8_t bipolarB = 0;
+    Pattern pattern;
+};
+
+// Clock edge detector with sub-sample edge estimation.
+// Same hysteresis as dsp::SchmittTrigger (low 0V, high 1V, starts high so a
+// clock that is already high on load does not fire). On a rising edge it also
+// estimates, from the slope between the previous and current sample, how far
+// before the current sample the signal crossed the high threshold.
+struct ClockEdgeDetector {
+    bool high = true;
+    float prevVoltage = 0.f;
+    float offset = 0.f;  // Fraction of a sample (0-1) the last edge lies before the current sample
+
+    bool process(float in, float lowThreshold = 0.f, float highThreshold = 1.f) {
+        bool rose = false;
+        if (high) {
+            if (in <= lowThreshold) high = false;
+        } else if (in >= highThreshold) {
+            high = true;
+            rose = true;
+            // Linear interpolation of the threshold crossing.
+            // A vertical edge (previous sample below low threshold, current at full
+            // level) still lands inside the sample interval.
+            float delta = in - prevVoltage;
+            offset = (delta > 0.f) ? std::min(1.f, (in - highThreshold) / delta) : 0.f;
+        }
+        prevVoltage = in;
+        return rose;
+    }
+
+    void reset() {
+        high = true;
+        prevVoltage = 0.f;
+        offset = 0.f;
+    }
+};
+
+// Clock period estimator used to predict the next clock edge.
+// The period is the median of the most recent intervals, so a single late or
+// early edge does not move the prediction. Times are in frames (samples).
+struct ClockPredictor {
+    static const int HISTORY = 5;
+    double lastEdge = 0.0;
+    double intervals[HISTORY] = {};
+    int intervalCount = 0;
+    int writeIndex = 0;
+    double period = 0.0;  // Estimated period (0 = unknown)
+    bool hasEdge = false;
+
+    void edge(double time) {
+        if (hasEdge) {
+            double interval = time - lastEdge;
+            // A gap much longer than the current period means the clock stopped
+            // and restarted, so the old history no longer describes it
+            if (period > 0.0 && interval > 4.0 * period) {
+                intervalCount = 0;
+                writeIndex = 0;
+                period = 0.0;
+            } else if (interval > 0.0) {
+                intervals[writeIndex] = interval;
+                writeIndex = (writeIndex + 1) % HISTORY;
+                if (intervalCount < HISTORY) intervalCount++;
+                period = medianInterval();
+            }
+        }
+        lastEdge = time;
+        hasEdge = true;
+    }
+
+    double medianInterval() const {
+        double sorted[HISTORY];
+        for (int i = 0; i < intervalCount; i++) {
+            // Insertion sort, at most HISTORY elements
+            double v = intervals[i];
+            int j = i;
+            while (j > 0 && sorted[j - 1] > v) {
+                sorted[j] = sorted[j - 1];
+                j--;
+            }
+            sorted[j] = v;
+        }
+        return sorted[intervalCount / 2];
+    }
+
+    // True while `now` is within `window` frames of the predicted next edge.
+    // Once the window has passed without an edge the prediction is considered missed.
+    bool isEdgeDue(double now, double window) const {
+        if (period <= 0.0) return false;
+        double next = lastEdge + period;
+        return now >= next - window && now < next + window;
+    }
+
+    void reset() {
+        intervalCount = 0;
+        writeIndex = 0;
+        period = 0.0;
+        hasEdge = false;
+    }
+};
+
+// Jitter filter for MIDI clock ticks (24 per quarter note).
+// Ticks arrive with the timing jitter of the sender, the USB bus and the MIDI
+// driver. An alpha-beta tracking loop follows the tick time and period: each
+// tick moves the estimate only part of the way towards the time it was
+// received, so filtered ticks are evenly spaced yet follow tempo changes.
+// Times are in frames (samples).
+struct MidiClockFilter {
+    static constexpr double TIME_GAIN = 0.1;     // Share of a tick's timing error applied to its time
+    static constexpr double PERIOD_GAIN = 0.005;  // Share applied to the period (tempo tracking)
+    double time = 0.0;      // Filtered time of the last tick
+    double period = 0.0;    // Filtered tick period (0 = unknown)
+    double lastTick = 0.0;  // Received time of the last tick
+    bool hasTick = false;
+
+    // Filter a tick received at `tick`. Returns its filtered time.
+    double process(double tick) {
+        double interval = tick - lastTick;
+        lastTick = tick;
+        if (!hasTick || interval <= 0.0) {
+            hasTick = true;
+            time = tick;
+            return time;
+        }
+        // The first interval, or a gap that means the clock paused and may come
+        // back at another tempo, (re)starts tracking from the received tick
+        if (period <= 0.0 || interval > 4.0 * period) {
+            period = (period <= 0.0) ? interval : 0.0;
+            time = tick;
+            return time;
+        }
+        double predicted = time + period;
+        double error = tick - predicted;
+        time = predicted + TIME_GAIN * error;
+        period += PERIOD_GAIN * error;
+        return time;
+    }
+
+    void reset() {
+        period = 0.0;
+        hasTick = false;
+    }
+};
+
+// MIDI clock transport and per-sequencer division (Sequencer::midiClockDivision).
+// Ticks step sequencers only between Start/Continue and Stop; Start also rewinds
+// the dividers so the first tick steps every sequencer.
+struct MidiClockDivider {
+    MidiClockFilter filter;
+    int ticks[8] = {0};    // Ticks per sequencer since its last step (0 = next tick steps)
+    bool running = false;  // Between Start/Continue and Stop
+
+    // Handle a tick received at `received`, setting *time to its filtered time.
+    // Returns the sequencers it steps.
+    uint8_t tick(double received, const Sequencer* sequencers, double* time) {
+        *time = filter.process(received);
+        if (!running) return 0;
+        uint8_t stepped = 0;
+        for (int s = 0; s < 8; s++) {
+            if (ticks[s] == 0) stepped |= 1 << s;
+            ticks[s] = (ticks[s] + 1) % std::max(1, sequencers[s].midiClockDivision);
+        }
+        return stepped;
+    }
+
+    void start() {
+        running = true;
+        for (int s = 0; s < 8; s++) ticks[s] = 0;
+    }
+
+    void resume() { running = true; }
+    void stop() { running = false; }
+};
+
+// Which outputs fired on a clock
+struct ClockResult {
+    bool fireA = false;
+    bool fireB = false;
+    bool echoA = false;  // Echo of A's lost competition on the previous A clock
+    bool echoB = false;  // Echo of B's lost competition on the previous B clock
+};
+
+// Competition kernel: decides whether A wins when A and B both want to fire.
+// Each CompetitionMode is its own specialisation of competitionKernel<MODE>.
+typedef bool (*CompetitionKernel)(Sequencer& seq, EngineRandom& rng, bool isAClock);
+
+// Routing kernel: sends a fired single-mode step to A or B.
+// Each RoutingMode is its own specialisation of routingKernel<MODE>.
+typedef void (*RoutingKernel)(Sequencer& seq, EngineRandom& rng, ClockResult& result);
+
+template <int MODE>
+bool competitionKernel(Sequencer& seq, EngineRandom& rng, bool isAClock);
+template <int MODE>
+void routingKernel(Sequencer& seq, EngineRandom& rng, ClockResult& result);
+
+// A trigger or gate scheduled for a future time
+struct ScheduledEvent {
+    double time = 0.0;    // Start time in frames (fractional part = sub-sample position)
+    float length = 1e-3f; // Pulse/gate length in seconds
+    uint8_t output = 0;   // 0 = A, 1 = B
+};
+
+// Fixed-capacity, time-ordered event queue. Storage is preallocated and
+// events are kept sorted latest-first, so checking and popping the next due
+// event is O(1) and nothing is allocated on the audio thread.
+template <int CAPACITY>
+struct EventQueue {
+    ScheduledEvent events[CAPACITY];
+    int count = 0;
+
+    // Insert an event in time order. Returns false (event dropped) if full.
+    bool push(const ScheduledEvent& event) {
+        if (count >= CAPACITY) return false;
+        int i = count;
+        // Shift earlier events up to keep the earliest at the end
+        while (i > 0 && events[i - 1].time < event.time) {
+            events[i] = events[i - 1];
+            i--;
+        }
+        events[i] = event;
+        count++;
+        return true;
+    }
+
+    // Pop the earliest event if it is due at `now`
+    bool popDue(double now, ScheduledEvent* event) {
+        if (count == 0 || events[count - 1].time > now) return false;
+        *event = events[--count];
+        return true;
+    }
+
+    bool empty() const { return count == 0; }
+    void clear() { count = 0; }
+};
+
+// Convert knob value (0-127) to voltage based on range and bipolar settings
+// Range: 0=5V, 1=10V, 2=1V
+// Bipolar: false=unipolar (0 to max), true=bipolar (-max/2 to +max/2)
+inline float knobToVoltage(float knobValue, int voltageRange, bool bipolar) {
+    float normalized = knobValue / 127.f;  // 0.0 to 1.0
+    float maxVoltage;
+    switch (voltageRange) {
+        case 0: maxVoltage = 5.f; break;   // Green: 5V
+        case 1: maxVoltage = 10.f; break;  // Amber: 10V
+        case 2: maxVoltage = 1.f; break;   // Red: 1V
+        default: maxVoltage = 5.f; break;
+    }
+    if (bipolar) {
+        return normalized * maxVoltage - (maxVoltage / 2.f);  // -max/2 to +max/2
+    } else {
+        return normalized * maxVoltage;  // 0 to max
+    }
+}
+
+// Apply exponential slew (RC filter style)
+// current: current output value
+// target: target value to slew toward
+// glideTime: time constant in seconds (0 = instant)
+// sampleTime: time for this sample
+inline float applySlewExp(float current, float target, float glideTime, float sampleTime) {
+    if (glideTime <= 0.f || glideTime < sampleTime) {
+        return target;  // No glide or glide time too short
+    }
+    // Exponential slew: move a percentage toward target each sample
+    // lambda = 1 - e^(-sampleTime / glideTime) for accurate RC filter
+    // Simplified: lambda = sampleTime / glideTime (good approximation for small values)
+    float lambda = std::min(1.f, sampleTime / glideTime * 4.f);  // *4 to reach target faster
+    return current + (target - current) * lambda;
+}
+
+// Euclidean rhythm of `hits` onsets spread over `length` steps (both clamped to
+// 0-MAX_STEPS): bit i is set if (i * hits) % length < hits. Read from a table
+// built at compile time, so it costs one lookup.
+uint64_t euclideanSteps(int hits, int length);
+
+// Rotate the first `length` bits by `amount` steps (positive = later); higher bits are dropped
+uint64_t rotateSteps(uint64_t bits, int length, int amount);
+
+struct SequencerEngine {
+    Sequencer sequencers[8];
+
+    // Copy buffer for sequencer copy/paste
+    Sequencer copyBuffer;
+
+    // Pattern slots per sequencer
+    PatternBank banks[8];
+
+    EngineRandom rng;
+
+    // Kernels for each sequencer's current competition/routing mode, selected when
+    // the mode is set. Kept here rather than in Sequencer so sequencers stay plain data.
+    CompetitionKernel competitionKernels[8];
+    RoutingKernel routingKernels[8];
+
+    // Incremented whenever a step or value length A or the page count of any
+    // sequencer is set, so callers can tell when to re-read them
+    uint32_t lengthRevision = 0;
+
+    SequencerEngine();
+
+    // Kernel for a mode (out-of-range modes fall back to the first mode)
+    static CompetitionKernel getCompetitionKernel(int mode);
+    static RoutingKernel getRoutingKernel(int mode);
+
+    // Set a sequencer's mode and select its kernel. Always change modes through these.
+    void setCompetitionMode(int seqIndex, int mode);
+    void setRoutingMode(int seqIndex, int mode);
+
+    // Clock entry point: dispatches to single or dual processing.
+    // Single step mode only uses clock A.
+    ClockResult processClock(int seqIndex, bool clockARose, bool clockBRose);
+
+    // Single mode clock processing: one sequencer, routing to A or B
+    ClockResult processSequencerClockSingle(int seqIndex);
+    // Dual mode clock A processing: Seq A step, returns true if A fires
+    bool processSequencerClockDualA(int seqIndex);
+    // Dual mode clock B processing: Seq B step, returns true if B fires
+    bool processSequencerClockDualB(int seqIndex);
+
+    // Advance the playheads of `seq` as the next clock A/B would, without
+    // resolving competition or touching the RNG (assumes an active step fires).
+    // Used to preview the upcoming playhead, e.g. for LED lookahead.
+    static void previewClock(Sequencer& seq, bool clockA, bool clockB);
+
+    // Resolve competition between A and B, returns true if A wins
+    bool resolveCompetition(int seqIndex, bool aWants, bool bWants, bool isAClock);
+
+    // Length/bias parameters from a knob value (0-127)
+    void setValueLengthA(int seqIndex, int knobValue);
+    void setValueLengthB(int seqIndex, int knobValue);
+    void setStepLengthA(int seqIndex, int knobValue);
+    void setStepLengthB(int seqIndex, int knobValue);
+    void setBias(int seqIndex, int knobValue);
+    // Set a step's trig condition (takes effect immediately)
+    void setStepCondition(int seqIndex, int step, int condition);
+    void setFill(int seqIndex, bool fill);
+    // Re-evaluate the conditions of the steps in `mask` for the current loop.
+    // Called whenever a loop starts: a few mask operations and at most two RNG
+    // draws decide every conditional step of the loop.
+    void evaluateConditions(int seqIndex, uint64_t mask);
+
+    // Clamp the step and value lengths to the ranges their knobs can set, and keep
+    // the playheads within them. For lengths read from patch or preset files.
+    void clampLengths(int seqIndex);
+
+    // Number of step pages (clamped to 1-MAX_PAGES). Steps on removed pages are
+    // cleared; a step length that covered every page keeps covering every page.
+    void setPages(int seqIndex, int pages);
+
+    // Playhead resets
+    void resetPlayheads(int seqIndex);
+    void resetAllPlayheads();
+    // Park the playheads on the last step/value, so the next clock plays the first
+    void parkPlayheads(int seqIndex);
+
+    // Sequencer utilities (steps on the pages in use)
+    void copySequencer(int seqIndex);
+    void pasteSteps(int seqIndex);
+    void clearSteps(int seqIndex);
+    void randomizeSteps(int seqIndex);
+    void invertSteps(int seqIndex);
+    // Randomize the 16 value knobs of a sequencer layout
+    void randomizeValues(int* values);
+
+    // Step generators for the steps of sequence A (which = 0) or B (1, dual mode
+    // only) within its step length. Steps beyond the length are kept.
+    void euclideanFill(int seqIndex, int which, int hits);
+    // Rotate the steps (with their conditions) by `amount` steps (positive = later)
+    void rotateSequence(int seqIndex, int which, int amount);
+
+    // Pattern bank. `knobs` is the sequencer layout's 24 knob values, which are
+    // part of a pattern (value knobs, plus the parameter knobs behind bias and CV 1-3).
+    // Store the live sequencer in a slot
+    void storePattern(int seqIndex, int slot, const int* knobs);
+    // Copy the live sequencer into a pattern
+    void capturePattern(int seqIndex, const int* knobs, Pattern* pattern) const;
+    // Replace the live sequencer with a slot (playheads are kept in range)
+    void loadPattern(int seqIndex, int slot, int* knobs);
+    // Switch to `slot` at the next loop boundary (the clock A that wraps step A to 0).
+    // Queuing the active slot cancels a pending switch.
+    void queuePattern(int seqIndex, int slot);
+    // Whether this clock is the loop boundary a queued switch waits for. Call before processClock().
+    bool isPatternSwitchDue(int seqIndex, bool clockARose) const;
+    // Write the live sequencer back to its slot and load the queued one, so the
+    // next clock starts the new pattern at step 1
+    void switchToQueuedPattern(int seqIndex, int* knobs);
+
+    // Preset library records (see PresetLibrary.hpp).
+    // Write the live sequencer into a record. Only reads the engine, so the UI
+    // thread can fill a staging record while the audio thread plays.
+    void storePreset(int seqIndex, const int* knobs, PresetRecord* record) const;
+    // Copy a record into the active pattern slot and load it like a pattern switch
+    void loadPreset(int seqIndex, const PresetRecord* record, int* knobs);
+
+    // Advance the CV A/B slew of one sequencer by one sample.
+    // values: the sequencer layout's knob values (at least 16), as int (MIDI)
+    // or float (morphed) values in the 0-127 range
+    template <typename T>
+    void processSlew(int seqIndex, const T* values, float sampleTime);
+};
@@ -17,15 +17,15 @@ struct StepDisplay : Module {
         LIGHTS_LEN
     };
 
-    LCXLExpanderMessage leftMessages[2];
-    LCXLExpanderMessage expanderMessage;  // For forwarding to right
+    LCXLChainLink link;  // Core's shared snapshot, received from the left and passed on
+    dsp::ClockDivider controlDivider;  // Control-rate scheduler, division follows Core
 
     StepDisplay() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
+        controlDivider.setDivision(32);
 
         // Setup expander message buffers
-        leftExpander.producerMessage = &leftMessages[0];
-        leftExpander.consumerMessage = &leftMessages[1];
+        link.attach(this);
     }
 
     bool isValidExpander(Module* m) {
@@ -36,30 +36,34 @@ struct StepDisplay : Module {
     }
 
     void process(const ProcessArgs& args) override {
-        bool connected = false;
-        LCXLExpanderMessage* msg = nullptr;
+        bool controlTick = controlDivider.process();  // Lights/display run at Core's control rate
 
-        // Check if connected to Core or another expander on the left
-        if (isValidExpander(leftExpander.module)) {
-            msg = reinterpret_cast<LCXLExpanderMessage*>(leftExpander.consumerMessage);
-            if (msg && msg->moduleId >= 0) {
-                connected = true;
+        // Get Core's snapshot from the left neighbour and pass it on to the right
+        bool fresh = false;  // Core published since the last frame
+        const LCXLExpanderMessage* msg = link.receive(this, isValidExpander(leftExpander.module), &fresh);
+        bool connected = msg != nullptr;
+        link.forward(rightExpander.module);
 
-                // Update LEDs for all 8 sequencers
+        if (connected) {
+            controlDivider.setDivision(msg->controlRateDivision);
+
+            if (controlTick) {
+                // Update LEDs for all 8 sequencers (control rate)
                 for (int s = 0; s < 8; s++) {
                     auto& seq = msg->sequencers[s];
 
                     for (int step = 0; step < 16; step++) {
                         int lightIndex = (s * 16 + step) * 2;
 
-                        bool isActive = seq.steps[step];
+                        bool isActive = (seq.steps >> step) & 1;
                         bool isPlayhead = false;
                         bool inRange = false;
 
                         if (seq.isStepSingleMode) {
-                            // Single mode: all 16 steps for sequence A
-                            isPlayhead = (step == seq.currentStepA);
-                            inRange = (step < seq.stepLengthA);
+                            // Single mode: all 16 steps for sequence A, from the shown page
+                            int pageStep = 16 * seq.page + step;
+                            isPlayhead = (pageStep == seq.currentStepA);
+                            inRange = (pageStep < seq.stepLengthA);
                         } else {
                             // Dual mode: top 8 for A, bottom 8 for B
                             if (step < 8) {
@@ -101,28 +105,19 @@ struct StepDisplay : Module {
                     }
                 }
 
-                // Store for forwarding
-                expanderMessage = *msg;
-            }
-        }
-
-        // Forward message to right expander
-        if (rightExpander.module && connected) {
-            LCXLExpanderMessage* rightMsg = reinterpret_cast<LCXLExpanderMessage*>(rightExpander.module->leftExpander.producerMessage);
-            if (rightMsg) {
-                *rightMsg = expanderMessage;
-                rightExpander.module->leftExpander.messageFlipRequested = true;
             }
         }
 
         // If not connected, turn off all LEDs
-        if (!connected) {
+        if (!connected && controlTick) {
             for (int i = 0; i < 8 * 16 * 2; i++) {
                 lights[STEP_LIGHTS + i].setBrightness(0.f);
             }
         }
 
-        lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        if (controlTick) {
+            lights[CONNECTED_LIGHT].setBrightness(connected ? 1.f : 0.f);
+        }
     }
 };
 
@@ -0,0 +1,232 @@
+#include "VirtualLCXL.hpp"
+#include "LCXLProtocol.hpp"
+#include <cstring>
+
+VirtualLCXL::VirtualLCXL() {
+    output.device = this;
+    std::memset(leds, LCXL::LED_OFF, sizeof(leds));
+    windowStart = Clock::now();
+}
+
+VirtualLCXL::~VirtualLCXL() {
+    stopPlayer();
+}
+
+VirtualLCXL* VirtualLCXL::get() {
+    static VirtualLCXL device;
+    return &device;
+}
+
+void VirtualLCXL::receive(const midi::Message& message) {
+    const std::vector<uint8_t>& b = message.bytes;
+    if (b.empty()) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Clock::time_point now = Clock::now();
+    rollWindow(now);
+    messages++;
+    bytes += b.size();
+
+    int updates = 0;
+    bool isSysEx = b.size() >= 9 && b[0] == 0xF0 && b[1] == 0x00 && b[2] == 0x20 && b[3] == 0x29
+                   && b[4] == 0x02 && b[5] == 0x11;
+    if (isSysEx && b[6] == 0x78) {
+        // Set LEDs: F0 00 20 29 02 11 78 [template] ([index] [color])... F7
+        int tmpl = b[7] & 0x0F;
+        for (size_t i = 8; i + 1 < b.size() && b[i] != 0xF7; i += 2) {
+            if (b[i] < NUM_LEDS) {
+                leds[tmpl][b[i]] = b[i + 1];
+                updates++;
+            }
+        }
+    } else if (isSysEx && b[6] == 0x77) {
+        // Change template: F0 00 20 29 02 11 77 [template] F7
+        currentTemplate = b[7] & 0x0F;
+    } else if (b.size() >= 3 && (b[0] & 0xF0) == 0xB0 && b[1] == 0 && b[2] == 0) {
+        // Reset: Bn 00 00 turns all LEDs of template n off
+        std::memset(leds[b[0] & 0x0F], LCXL::LED_OFF, NUM_LEDS);
+        updates = 1;
+    }
+
+    if (updates > 0) {
+        ledUpdates += updates;
+        if (awaitingLED) {
+            double latency = std::chrono::duration<double, std::milli>(now - lastInputTime).count();
+            latencySum += latency;
+            latencyCount++;
+            latencyMax = std::max(latencyMax, latency);
+            awaitingLED = false;
+        }
+    }
+}
+
+uint8_t VirtualLCXL::getLED(int tmpl, int index) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return leds[tmpl & 0x0F][index];
+}
+
+int VirtualLCXL::getTemplate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return currentTemplate;
+}
+
+VirtualLCXL::Stats VirtualLCXL::getStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    rollWindow(Clock::now());
+    return stats;
+}
+
+void VirtualLCXL::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats = Stats();
+    messages = bytes = ledUpdates = inputs = 0;
+    latencySum = 0.0;
+    latencyCount = 0;
+    latencyMax = 0.0;
+    awaitingLED = false;
+    windowStart = Clock::now();
+}
+
+void VirtualLCXL::rollWindow(Clock::time_point now) {
+    double elapsed = std::chrono::duration<double>(now - windowStart).count();
+    if (elapsed < 1.0) return;
+
+    stats.messagesPerSecond = messages / elapsed;
+    stats.bytesPerSecond = bytes / elapsed;
+    stats.ledUpdatesPerSecond = ledUpdates / elapsed;
+    stats.inputsPerSecond = inputs / elapsed;
+    stats.latencyAverage = latencyCount > 0 ? latencySum / latencyCount : 0.f;
+    stats.latencyMax = latencyMax;
+
+    messages = bytes = ledUpdates = inputs = 0;
+    latencySum = 0.0;
+    latencyCount = 0;
+    latencyMax = 0.0;
+    windowStart = now;
+}
+
+void VirtualLCXL::startPlayer() {
+    if (running) return;
+    running = true;
+    player = std::thread(&VirtualLCXL::runPlayer, this);
+}
+
+void VirtualLCXL::stopPlayer() {
+    running = false;
+    if (player.joinable()) player.join();
+}
+
+void VirtualLCXL::runPlayer() {
+    uint32_t n = 0;
+    double due = 0.0;  // Scripted messages owed since the last tick
+    Clock::time_point last = Clock::now();
+
+    while (running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        Clock::time_point now = Clock::now();
+        double dt = std::chrono::duration<double>(now - last).count();
+        last = now;
+
+        int s = script;
+        if (s == SCRIPT_OFF) {
+            due = 0.0;
+            continue;
+        }
+        due += dt * rate;
+
+        int channel = getTemplate();
+        for (; due >= 1.0; due -= 1.0) {
+            input.onMessage(scriptedMessage(s, n++, channel));
+
+            std::lock_guard<std::mutex> lock(mutex);
+            rollWindow(now);
+            inputs++;
+            if (!awaitingLED) {
+                lastInputTime = Clock::now();
+                awaitingLED = true;
+            }
+        }
+    }
+}
+
+midi::Message VirtualLCXL::scriptedMessage(int s, uint32_t n, int channel) {
+    midi::Message msg;
+    msg.setChannel(channel);
+
+    // Knob sweep: knob n % 24, values running up and down 0-127
+    auto knob = [&](uint32_t i, uint32_t step) {
+        static const int* const rows[3] = {LCXL::KNOB_ROW1, LCXL::KNOB_ROW2, LCXL::KNOB_ROW3};
+        int k = i % 24;
+        int v = step % 254;
+        msg.setStatus(0xb);
+        msg.setNote(rows[k / 8][k % 8]);
+        msg.setValue(v < 128 ? v : 253 - v);
+    };
+    // Button: press on even n, release on odd n
+    auto button = [&](uint32_t i, bool press) {
+        int b = i % 16;
+        msg.setStatus(press ? 0x9 : 0x8);
+        msg.setNote(b < 8 ? LCXL::TRACK_FOCUS[b] : LCXL::TRACK_CONTROL[b - 8]);
+        msg.setValue(press ? 127 : 0);
+    };
+
+    switch (s) {
+        case SCRIPT_KNOBS:
+            knob(n, n / 24);
+            break;
+        case SCRIPT_BUTTONS:
+            button(n / 2, n % 2 == 0);
+            break;
+        case SCRIPT_STORM: {
+            // Deterministic hash of n, so runs are reproducible
+            uint32_t h = n * 2654435761u;
+            h ^= h >> 15;
+            switch (h % 3) {
+                case 0: knob(h >> 2, h >> 7); break;
+                case 1:
+                    msg.setStatus(0xb);
+                    msg.setNote(LCXL::FADERS[(h >> 2) % 8]);
+                    msg.setValue((h >> 5) % 128);
+                    break;
+                default: button(n / 2, n % 2 == 0); break;
+            }
+            break;
+        }
+    }
+    return msg;
+}
+
+std::string VirtualLCXLDriver::getInputDeviceName(int deviceId) {
+    return deviceId == 0 ? VirtualLCXL::get()->input.getName() : "";
+}
+
+midi::InputDevice* VirtualLCXLDriver::subscribeInput(int deviceId, midi::Input* input) {
+    if (deviceId != 0) return nullptr;
+    VirtualLCXL* device = VirtualLCXL::get();
+    device->input.subscribe(input);
+    device->startPlayer();
+    return &device->input;
+}
+
+void VirtualLCXLDriver::unsubscribeInput(int deviceId, midi::Input* input) {
+    if (deviceId != 0) return;
+    VirtualLCXL* device = VirtualLCXL::get();
+    device->input.unsubscribe(input);
+    if (device->input.subscribed.empty()) device->stopPlayer();
+}
+
+std::string VirtualLCXLDriver::getOutputDeviceName(int deviceId) {
+    return deviceId == 0 ? VirtualLCXL::get()->output.getName() : "";
+}
+
+midi::OutputDevice* VirtualLCXLDriver::subscribeOutput(int deviceId, midi::Output* output) {
+    if (deviceId != 0) return nullptr;
+    VirtualLCXL* device = VirtualLCXL::get();
+    device->output.subscribe(output);
+    return &device->output;
+}
+
+void VirtualLCXLDriver::unsubscribeOutput(int deviceId, midi::Output* output) {
+    if (deviceId != 0) return;
+    VirtualLCXL::get()->output.unsubscribe(output);
+}
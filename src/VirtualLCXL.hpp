@@ -0,0 +1,121 @@
+#pragma once
+#include "plugin.hpp"
+#include <midi.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+// Software stand-in for a Launch Control XL, registered as the "LCXL Virtual"
+// MIDI driver. Select it as Core's MIDI input and output to exercise the LED,
+// template and takeover logic without the controller:
+// - Messages from Core are parsed like the controller does (LED SysEx, template
+//   change, reset) into an LED mirror per template
+// - A scripted player sends knob/fader/button messages at a set rate on the
+//   selected template's channel
+// - Traffic from Core is counted, and the time from a scripted input to the
+//   first LED message that follows it is measured
+struct VirtualLCXL {
+    static constexpr int DRIVER_ID = 0x4C43;  // 'LC', clear of Rack's own driver ids
+    static constexpr int NUM_TEMPLATES = 16;
+    static constexpr int NUM_LEDS = 48;       // Same indices as LCXLDevice
+
+    enum Script {
+        SCRIPT_OFF = 0,
+        SCRIPT_KNOBS,    // Sweep all 24 knobs
+        SCRIPT_BUTTONS,  // Press and release the 16 track buttons in turn
+        SCRIPT_STORM,    // Random mix of knobs, faders and buttons
+        NUM_SCRIPTS
+    };
+
+    // Measured over the last complete second
+    struct Stats {
+        float messagesPerSecond = 0.f;    // Messages from Core
+        float bytesPerSecond = 0.f;
+        float ledUpdatesPerSecond = 0.f;  // LED changes (SysEx index/color pairs, resets count 1)
+        float inputsPerSecond = 0.f;      // Scripted messages sent to Core
+        float latencyAverage = 0.f;       // Scripted input to next LED message (ms)
+        float latencyMax = 0.f;
+    };
+
+    struct InputDevice : midi::InputDevice {
+        std::string getName() override { return "Launch Control XL (virtual)"; }
+    };
+
+    struct OutputDevice : midi::OutputDevice {
+        VirtualLCXL* device = nullptr;
+        std::string getName() override { return "Launch Control XL (virtual)"; }
+        void sendMessage(const midi::Message& message) override { device->receive(message); }
+    };
+
+    InputDevice input;
+    OutputDevice output;
+
+    VirtualLCXL();
+    ~VirtualLCXL();
+
+    // The one virtual controller (shared by every Core that selects it)
+    static VirtualLCXL* get();
+
+    // Handle a message sent by Core
+    void receive(const midi::Message& message);
+
+    uint8_t getLED(int tmpl, int index);
+    int getTemplate();
+
+    void setScript(int s) { script = s; }
+    int getScript() const { return script; }
+    void setRate(int messagesPerSecond) { rate = messagesPerSecond; }
+    int getRate() const { return rate; }
+
+    Stats getStats();
+    void resetStats();
+
+    // Run the scripted player while Cores are listening
+    void startPlayer();
+    void stopPlayer();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    std::mutex mutex;
+    uint8_t leds[NUM_TEMPLATES][NUM_LEDS];
+    int currentTemplate = 8;  // Factory template 1
+
+    // Counters of the current one-second window
+    Clock::time_point windowStart;
+    int messages = 0;
+    int bytes = 0;
+    int ledUpdates = 0;
+    int inputs = 0;
+    double latencySum = 0.0;
+    int latencyCount = 0;
+    double latencyMax = 0.0;
+    Stats stats;
+
+    Clock::time_point lastInputTime;
+    bool awaitingLED = false;  // A scripted input hasn't been answered by an LED message yet
+
+    std::thread player;
+    std::atomic<bool> running{false};
+    std::atomic<int> script{SCRIPT_OFF};
+    std::atomic<int> rate{100};
+
+    void runPlayer();
+    midi::Message scriptedMessage(int script, uint32_t n, int channel);
+    void rollWindow(Clock::time_point now);  // Call with mutex held
+};
+
+struct VirtualLCXLDriver : midi::Driver {
+    std::string getName() override { return "LCXL Virtual"; }
+    std::vector<int> getInputDeviceIds() override { return {0}; }
+    int getDefaultInputDeviceId() override { return 0; }
+    std::string getInputDeviceName(int deviceId) override;
+    midi::InputDevice* subscribeInput(int deviceId, midi::Input* input) override;
+    void unsubscribeInput(int deviceId, midi::Input* input) override;
+    std::vector<int> getOutputDeviceIds() override { return {0}; }
+    int getDefaultOutputDeviceId() override { return 0; }
+    std::string getOutputDeviceName(int deviceId) override;
+    midi::OutputDevice* subscribeOutput(int deviceId, midi::Output* output) override;
+    void unsubscribeOutput(int deviceId, midi::Output* output) override;
+};
@@ -1,4 +1,7 @@
 #include "plugin.hpp"
+#ifdef VIRTUAL_LCXL
+#include "VirtualLCXL.hpp"
+#endif
 
 Plugin* pluginInstance;
 
@@ -14,4 +17,9 @@ void init(Plugin* p) {
     p->addModel(modelStepDisplay);
     p->addModel(modelInfoDisplay);
     p->addModel(modelCVExpander);
+
+#ifdef VIRTUAL_LCXL
+    // Software controller for running Core without a Launch Control XL (development builds)
+    midi::addDriver(VirtualLCXL::DRIVER_ID, new VirtualLCXLDriver);
+#endif
 }
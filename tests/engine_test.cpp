@@ -0,0 +1,383 @@
+// Golden-trace test and benchmark of the standalone sequencer engine.
+//
+//   make engine-test    Replay the traces in tests/golden and run the checks below,
+//                       failing on any mismatch
+//   make engine-bench   Measure clocks per second of every competition/routing mode
+//
+// The golden traces were generated from the clock logic of Core before it was
+// moved into SequencerEngine, so they pin the engine to the original behavior.
+// Each line holds one configuration (mode, lengths, bias, steps, random seed)
+// and the trace it produced: per tick, the outputs that fired ('0' + A + 2*B),
+// then value index A and, in dual mode, value index B (hex).
+#include "SequencerEngine.hpp"
+#include "EditJournal.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+
+const int TICKS = 48;
+const uint64_t SEED_B = 0x5EED;
+const char* const HEX = "0123456789abcdef";
+
+// Clock schedule shared with the trace generator: A on two of every three ticks,
+// B on every other tick, so A and B clocks both coincide and alternate
+bool clockAAt(int tick) { return tick % 3 != 2; }
+bool clockBAt(int tick) { return tick % 2 == 0; }
+
+struct TraceConfig {
+    bool dual = true;
+    int mode = 0;
+    int stepLengthA = 8;
+    int stepLengthB = 0;
+    int valueLengthA = 8;
+    int valueLengthB = 0;
+    int bias = 50;        // Percent
+    unsigned steps = 0;   // Steps 0-15
+    int seed = 0;
+};
+
+std::string runTrace(SequencerEngine& engine, const TraceConfig& config) {
+    engine.sequencers[0] = Sequencer();
+    engine.rng.seed(config.seed, SEED_B);
+    Sequencer& seq = engine.sequencers[0];
+    seq.steps = config.steps;
+    seq.stepLengthA = config.stepLengthA;
+    seq.stepLengthB = config.stepLengthB;
+    seq.valueLengthA = config.valueLengthA;
+    seq.valueLengthB = config.valueLengthB;
+    seq.bias = config.bias / 100.f;
+    engine.setCompetitionMode(0, config.dual ? config.mode : COMP_INDEPENDENT);
+    engine.setRoutingMode(0, config.dual ? ROUTE_ALL_A : config.mode);
+
+    std::string trace;
+    for (int t = 0; t < TICKS; t++) {
+        ClockResult fired = engine.processClock(0, clockAAt(t), clockBAt(t));
+        trace += (char) ('0' + (fired.fireA ? 1 : 0) + (fired.fireB ? 2 : 0));
+        trace += HEX[seq.currentValueIndexA & 15];
+        if (config.dual) trace += HEX[seq.currentValueIndexB & 15];
+    }
+    return trace;
+}
+
+// Value Theft was a placeholder that played the winner's own value. The engine
+// plays the loser's value instead, so only its fire decisions are compared.
+bool tracesMatch(const TraceConfig& config, const std::string& expected, const std::string& actual) {
+    if (expected.size() != actual.size()) return false;
+    if (!(config.dual && config.mode == COMP_VALUE_THEFT)) return expected == actual;
+    for (size_t i = 0; i < expected.size(); i += 3) {
+        if (expected[i] != actual[i]) return false;
+    }
+    return true;
+}
+
+// Replay one golden file. Returns the number of failed traces, or -1 if the file can't be read.
+int checkGoldenFile(SequencerEngine& engine, const std::string& path, int* count) {
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        std::fprintf(stderr, "Can't open %s\n", path.c_str());
+        return -1;
+    }
+    int failures = 0;
+    char line[512];
+    while (std::fgets(line, sizeof(line), file)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        char kind[8];
+        char expected[256];
+        TraceConfig config;
+        if (std::sscanf(line, "%7s %d %d %d %d %d %d %x %d %255s", kind, &config.mode,
+                        &config.stepLengthA, &config.stepLengthB, &config.valueLengthA,
+                        &config.valueLengthB, &config.bias, &config.steps, &config.seed, expected) != 10) {
+            std::fprintf(stderr, "%s: malformed line: %s", path.c_str(), line);
+            failures++;
+            continue;
+        }
+        config.dual = std::strcmp(kind, "comp") == 0;
+        (*count)++;
+
+        std::string actual = runTrace(engine, config);
+        if (!tracesMatch(config, expected, actual)) {
+            if (failures < 10) {
+                std::fprintf(stderr, "%s: %s mode %d, seed %d\n  expected %s\n  actual   %s\n",
+                             path.c_str(), kind, config.mode, config.seed, expected, actual.c_str());
+            }
+            failures++;
+        }
+    }
+    std::fclose(file);
+    return failures;
+}
+
+int checkFailed(const char* what) {
+    std::fprintf(stderr, "FAIL: %s\n", what);
+    return 1;
+}
+
+// Undo journal: dropping one layout's records keeps the others' history in order
+int checkJournal() {
+    int failures = 0;
+    EditJournal journal;
+    auto push = [&](int layout, int index, int value, bool chained) {
+        EditRecord record;
+        record.layout = layout;
+        record.index = index;
+        record.chained = chained ? 1 : 0;
+        record.newValue = value;
+        journal.push(record, true);
+    };
+    push(1, 0, 10, false);
+    push(2, 0, 20, false);
+    push(2, 1, 21, true);
+    push(1, 0, 11, false);  // Not merged: the previous record has another target
+    push(3, 0, 30, false);
+    journal.seal();
+    push(3, 0, 31, true);   // Chained to layout 3's edit
+    journal.undo([](const EditRecord&, bool) {});  // Layout 3's edit becomes redo history
+
+    journal.removeLayout(2);
+    if (journal.undoCount != 2 || journal.redoCount != 2) failures += checkFailed("journal counts after removeLayout");
+    int values[4] = {0};
+    int n = 0;
+    while (journal.undoCount > 0) journal.undo([&](const EditRecord& r, bool) { if (n < 4) values[n++] = r.newValue; });
+    if (n != 2 || values[0] != 11 || values[1] != 10) failures += checkFailed("journal undo order after removeLayout");
+    n = 0;
+    journal.redo([&](const EditRecord& r, bool) { if (n < 4) values[n++] = r.newValue; });
+    if (n != 1 || values[0] != 10) failures += checkFailed("journal redo after removeLayout");
+
+    // A sealed journal starts a new record for the same target
+    journal.clear();
+    push(1, 5, 1, false);
+    push(1, 5, 2, false);
+    journal.seal();
+    push(1, 5, 3, false);
+    if (journal.undoCount != 2) failures += checkFailed("journal merge and seal");
+    return failures;
+}
+
+int popcount(uint64_t bits) {
+    int n = 0;
+    for (; bits; bits &= bits - 1) n++;
+    return n;
+}
+
+// Euclidean table against its definition, and rotation
+int checkStepGenerators() {
+    int failures = 0;
+    for (int length = 0; length <= 64; length++) {
+        for (int hits = 0; hits <= length; hits++) {
+            uint64_t steps = euclideanSteps(hits, length);
+            uint64_t expected = 0;
+            for (int i = 0; i < length; i++) {
+                if ((i * hits) % length < hits) expected |= 1ull << i;
+            }
+            if (steps != expected || popcount(steps) != hits) {
+                std::fprintf(stderr, "E(%d,%d) = %llx\n", hits, length, (unsigned long long) steps);
+                failures += checkFailed("euclideanSteps differs from its definition");
+                return failures;
+            }
+        }
+    }
+    if (euclideanSteps(3, 8) != 0x49) failures += checkFailed("E(3,8) is x..x..x.");
+    if (euclideanSteps(9, 4) != 0xF || euclideanSteps(-2, 8) != 0) failures += checkFailed("euclideanSteps clamps hits");
+    if (euclideanSteps(64, 99) != ~0ull) failures += checkFailed("euclideanSteps clamps the length");
+
+    if (rotateSteps(0x1, 4, 1) != 0x2 || rotateSteps(0x1, 4, -1) != 0x8) failures += checkFailed("rotateSteps by one step");
+    if (rotateSteps(0x49, 8, 8) != 0x49 || rotateSteps(0x49, 8, -19) != rotateSteps(0x49, 8, 5)) {
+        failures += checkFailed("rotateSteps wraps the amount");
+    }
+    if (rotateSteps(0xF0F1, 8, 0) != 0xF1) failures += checkFailed("rotateSteps drops bits past the length");
+    if (rotateSteps(0x8000000000000001ull, 64, 1) != 0x3) failures += checkFailed("rotateSteps over 64 steps");
+    if (rotateSteps(0x5, 0, 1) != 0) failures += checkFailed("rotateSteps of an empty sequence");
+    for (int amount = -20; amount <= 20; amount++) {
+        if (rotateSteps(rotateSteps(0x2D3, 13, amount), 13, -amount) != 0x2D3) {
+            failures += checkFailed("rotateSteps back and forth");
+            break;
+        }
+    }
+    return failures;
+}
+
+// Density is part of a pattern and of a preset
+int checkPatternDensity(SequencerEngine& engine) {
+    int failures = 0;
+    int knobs[24] = {0};
+    engine.sequencers[0] = Sequencer();
+    engine.sequencers[0].density = 0.25f;
+    engine.storePattern(0, 1, knobs);
+    engine.sequencers[0].density = 1.f;
+    engine.loadPattern(0, 1, knobs);
+    if (engine.sequencers[0].density != 0.25f) failures += checkFailed("pattern density");
+
+    PresetRecord record;
+    engine.sequencers[0].density = 0.5f;
+    engine.storePreset(0, knobs, &record);
+    engine.sequencers[0].density = 1.f;
+    engine.loadPreset(0, &record, knobs);
+    if (engine.sequencers[0].density != 0.5f) failures += checkFailed("preset density");
+    return failures;
+}
+
+// Value Theft: a winner keeps playing the value it stole until its own next clock,
+// even when the loser's clock advances the loser's value index in between
+int checkValueTheft(SequencerEngine& engine) {
+    int failures = 0;
+    TraceConfig config;
+    config.mode = COMP_VALUE_THEFT;
+    config.stepLengthB = 8;
+    config.valueLengthB = 8;
+    config.steps = 0xFF55;  // B fires uncontested while A is on an off step
+    config.seed = 7;
+    runTrace(engine, config);  // Configures sequencer 0 and plays it into a varied state
+    Sequencer& seq = engine.sequencers[0];
+
+    int knobs[24];
+    for (int i = 0; i < 24; i++) knobs[i] = i * 5;
+    int thefts = 0;
+    for (int t = 0; t < 400; t++) {
+        bool clockA = t % 2 == 0;
+        engine.processClock(0, clockA, !clockA);
+        engine.processSlew(0, knobs, 1e-4f);
+        float cvA = seq.currentSlewA;
+        bool theftA = seq.theftA;
+        // B's clock alone must not change what A plays
+        engine.processClock(0, false, true);
+        engine.processSlew(0, knobs, 1e-4f);
+        if (theftA && seq.currentSlewA != cvA) {
+            failures += checkFailed("value theft: A's stolen value changed on B's clock");
+            break;
+        }
+        if (theftA) thefts++;
+    }
+    if (thefts == 0) failures += checkFailed("value theft: no theft happened");
+    return failures;
+}
+
+// MIDI clock: the filter evens out tick jitter, and the divider steps each
+// sequencer every midiClockDivision ticks while the transport runs
+int checkMidiClock(SequencerEngine& engine) {
+    int failures = 0;
+    const double PERIOD = 1000.0;  // Frames per tick (120 BPM at 48 kHz)
+    MidiClockFilter filter;
+    for (int t = 0; t < 100; t++) filter.process(t * PERIOD);
+    double tick = filter.process(100 * PERIOD + 100.0);  // About 2 ms late
+    if (std::abs(tick - 100 * PERIOD - 10.0) > 1e-6) failures += checkFailed("MIDI clock filter keeps a tenth of the error");
+    double worst = 0.0;
+    for (int t = 101; t < 400; t++) {
+        double jitter = (t % 2 ? 40.0 : -40.0);
+        tick = filter.process(t * PERIOD + jitter);
+        if (t > 200) worst = std::max(worst, std::abs(tick - t * PERIOD));
+    }
+    if (worst > 10.0) failures += checkFailed("MIDI clock filter evens out jitter");
+    if (std::abs(filter.period - PERIOD) > 1.0) failures += checkFailed("MIDI clock filter period");
+
+    for (int s = 0; s < 8; s++) engine.sequencers[s] = Sequencer();
+    engine.sequencers[0].midiClockDivision = 6;
+    engine.sequencers[1].midiClockDivision = 1;
+    engine.sequencers[2].midiClockDivision = 0;  // Treated as 1
+    MidiClockDivider clock;
+    double time = 0.0;
+    int frame = 0;
+    auto tickSeqs = [&]() { return clock.tick(frame++ * PERIOD, engine.sequencers, &time); };
+    if (tickSeqs() != 0) failures += checkFailed("MIDI clock steps before Start");
+
+    clock.start();
+    int steps[3] = {0};
+    for (int t = 0; t < 24; t++) {
+        uint8_t stepped = tickSeqs();
+        if (t == 0 && stepped != 0xFF) failures += checkFailed("MIDI clock Start steps every sequencer on the first tick");
+        for (int s = 0; s < 3; s++) steps[s] += (stepped >> s) & 1;
+    }
+    if (steps[0] != 4 || steps[1] != 24 || steps[2] != 24) failures += checkFailed("MIDI clock division");
+    if (std::abs(time - (frame - 1) * PERIOD) > 1e-6) failures += checkFailed("MIDI clock tick time");
+
+    tickSeqs();  // Sequencer 0 one tick into its step
+    clock.stop();
+    if (tickSeqs() != 0) failures += checkFailed("MIDI clock steps after Stop");
+    clock.resume();
+    if (tickSeqs() & 1) failures += checkFailed("MIDI clock Continue keeps the division phase");
+    clock.start();
+    if (!(tickSeqs() & 1)) failures += checkFailed("MIDI clock Start rewinds the division");
+    return failures;
+}
+
+// Clock all 8 sequencers in one mode and return clocks per second
+double benchmarkMode(SequencerEngine& engine, bool dual, int mode) {
+    const int CLOCKS = 2000000;
+    for (int s = 0; s < 8; s++) {
+        Sequencer& seq = engine.sequencers[s];
+        seq = Sequencer();
+        seq.steps = 0xB5E3u * (s + 1);
+        seq.stepLengthA = dual ? 5 + s % 4 : 9 + s;
+        seq.stepLengthB = dual ? 3 + s % 6 : 0;
+        seq.valueLengthA = dual ? 7 : 13;
+        seq.valueLengthB = dual ? 5 : 0;
+        engine.setCompetitionMode(s, dual ? mode : COMP_INDEPENDENT);
+        engine.setRoutingMode(s, dual ? ROUTE_ALL_A : mode);
+    }
+
+    int fires = 0;  // Keeps the results alive
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < CLOCKS / 8; i++) {
+        for (int s = 0; s < 8; s++) {
+            ClockResult fired = engine.processClock(s, clockAAt(i), clockBAt(i));
+            fires += fired.fireA + fired.fireB;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (fires < 0) std::printf("%d\n", fires);
+    return CLOCKS / seconds;
+}
+
+int runBenchmark(SequencerEngine& engine) {
+    static const char* const competitionNames[8] = {
+        "Independent", "Steal", "A Priority", "B Priority", "Momentum", "Revenge", "Echo", "Value Theft"};
+    static const char* const routingNames[8] = {
+        "All A", "All B", "Bernoulli", "Alternate", "Two-Two", "Burst", "Probability", "Pattern"};
+
+    engine.rng.seed(1, SEED_B);
+    std::printf("%-24s %12s\n", "Mode", "Clocks/s");
+    for (int mode = 0; mode < 8; mode++) {
+        std::printf("Competition %-12s %12.0f\n", competitionNames[mode], benchmarkMode(engine, true, mode));
+    }
+    for (int mode = 0; mode < 8; mode++) {
+        std::printf("Routing %-16s %12.0f\n", routingNames[mode], benchmarkMode(engine, false, mode));
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    static SequencerEngine engine;  // Static: the pattern banks make it large for the stack
+
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        return runBenchmark(engine);
+    }
+
+    std::string dir = argc > 1 ? argv[1] : "tests/golden";
+    int count = 0;
+    int failures = 0;
+    static const char* const files[] = {"competition.txt", "routing.txt"};
+    for (const char* name : files) {
+        int result = checkGoldenFile(engine, dir + "/" + name, &count);
+        if (result < 0) return 1;
+        failures += result;
+    }
+    if (failures > 0) {
+        std::fprintf(stderr, "%d of %d traces differ from the golden traces\n", failures, count);
+        return 1;
+    }
+    std::printf("All %d traces match the golden traces\n", count);
+
+    int checkFailures = checkJournal() + checkStepGenerators() + checkPatternDensity(engine)
+                        + checkValueTheft(engine) + checkMidiClock(engine);
+    if (checkFailures > 0) {
+        std::fprintf(stderr, "%d checks failed\n", checkFailures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}